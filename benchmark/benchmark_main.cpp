@@ -0,0 +1,12 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+// Command-line driver for the benchmark harness, e.g.
+//   SudokuBenchmark --engines bitmask,efficient --corpora hard,17-clue --size 500 --format json
+// Same options as `SudokuProject bench`.
+//
+#include "../include/cli.h"
+
+int main(int argc, char** argv) {
+    return runBenchCommand(vector<string>(argv + 1, argv + argc), "SudokuBenchmark");
+}
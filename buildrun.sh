@@ -2,13 +2,17 @@
 
 # Check if project directory is provided
 if [[ -z "$1" ]]; then
-    echo "Usage: $0 <path_to_project_dir> [program_arguments...]"
+    echo "Usage: [BUILD_TYPE=Debug|Release|RelWithDebInfo] $0 <path_to_project_dir> [program_arguments...]"
     exit 1
 fi
 
 PROJECT_DIR="$1"
 shift 1  # Remove the project directory argument; the rest (if any) are for the executable
 
+# Optimized by default; BUILD_TYPE=Debug gives the old cmake-build-debug build
+BUILD_TYPE="${BUILD_TYPE:-Release}"
+BUILD_DIR="cmake-build-$(echo "$BUILD_TYPE" | tr '[:upper:]' '[:lower:]')"
+
 # Check if the provided directory exists
 if [[ ! -d "$PROJECT_DIR" ]]; then
     echo "Error: Directory $PROJECT_DIR does not exist."
@@ -38,12 +42,12 @@ echo "░▒▓█▓▒░░▒▓█▓▒░      ░▒▓█▓▒░
 echo " ░▒▓██████▓▒░░▒▓███████▓▒░       ░▒▓████████▓▒░▒▓███████▓▒░░▒▓████████▓▒░░▒▓██████▓▒░  "
 
 # Remove existing build directory if it exists
-[[ -d "$PROJECT_DIR/cmake-build-debug" ]] && rm -rf "$PROJECT_DIR/cmake-build-debug"
+[[ -d "$PROJECT_DIR/$BUILD_DIR" ]] && rm -rf "$PROJECT_DIR/$BUILD_DIR"
 
 # Create build directory and compile the project
-mkdir -p "$PROJECT_DIR/cmake-build-debug"
-cmake -B "$PROJECT_DIR/cmake-build-debug" -S "$PROJECT_DIR"
-cmake --build "$PROJECT_DIR/cmake-build-debug"
+mkdir -p "$PROJECT_DIR/$BUILD_DIR"
+cmake -B "$PROJECT_DIR/$BUILD_DIR" -S "$PROJECT_DIR" -DCMAKE_BUILD_TYPE="$BUILD_TYPE"
+cmake --build "$PROJECT_DIR/$BUILD_DIR" --config "$BUILD_TYPE"
 
 echo "----------------------------------------"
 echo "------------COMPILATION DONE------------"
@@ -54,7 +58,7 @@ PROJECT_NAME="SudokuProject"
 echo "Project Name: $PROJECT_NAME"
 
 # Define build path based on environment
-BUILD_PATH="$PROJECT_DIR/cmake-build-debug/"
+BUILD_PATH="$PROJECT_DIR/$BUILD_DIR/"
 
 # Determine OS and run the executable accordingly, passing any additional arguments
 OS="$(uname)"
@@ -72,10 +76,10 @@ if [[ "$OS" == "Linux" || "$OS" == "Darwin" ]]; then
         exit 1
     fi
 elif [[ $OS =~ MINGW || $OS =~ CYGWIN || $OS =~ MSYS ]]; then
-    if [[ -f "$BUILD_PATH/Debug/$PROJECT_NAME.exe" ]]; then
-        "$BUILD_PATH/Debug/$PROJECT_NAME.exe" "$@"
+    if [[ -f "$BUILD_PATH/$BUILD_TYPE/$PROJECT_NAME.exe" ]]; then
+        "$BUILD_PATH/$BUILD_TYPE/$PROJECT_NAME.exe" "$@"
     else
-        echo "Error: Executable not found in $BUILD_PATH/Debug"
+        echo "Error: Executable not found in $BUILD_PATH/$BUILD_TYPE"
         exit 1
     fi
 else
@@ -0,0 +1,111 @@
+/**
+ * @file batch_solver.h
+ * @brief Solves many independent boards in lockstep with SIMD constraint propagation.
+ *
+ * The candidate masks of a batch are stored lane-major: `cand[cell][lane]` holds the 9-bit
+ * mask of `cell` in board `lane`, so one 16-bit SIMD lane carries one board. Every step of
+ * the propagation then runs on all boards of the batch with a single instruction:
+ * - Naked singles: digits fixed in a cell are removed from the other cells of its units.
+ * - Hidden singles: a digit that fits only one cell of a unit is placed there.
+ * - Contradictions: an empty cell, a digit fixed twice or a digit with no place in a unit.
+ *
+ * Propagation repeats until nothing changes. Boards that are then complete are done; the
+ * rest are handed with their propagated cells filled in to a per-board solver, so only the
+ * cells that really need branching are searched.
+ *
+ * The lane width follows the instruction set the file is compiled for: 16 boards with
+ * AVX2, 8 with SSE2 and 8 with the portable scalar fallback.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_BATCH_SOLVER_H
+#define SUDOKUPROJECT_BATCH_SOLVER_H
+
+#include <vector>
+#include "board.h"
+#include "sudoku.h"
+#include "solution_cache.h"
+using namespace std;
+
+#if defined(__AVX2__)
+const int BATCH_LANES = 16;  // 256-bit registers, 16 x uint16 masks
+#else
+const int BATCH_LANES = 8;   // 128-bit registers (or the scalar fallback), 8 x uint16 masks
+#endif
+
+/**
+ * @brief Name of the instruction set the batch solver was built for ("avx2", "sse2" or "scalar").
+ */
+const char* batchInstructionSet();
+
+/**
+ * @brief Solves `count` boards in-place, `BATCH_LANES` at a time.
+ *
+ * @param boards Boards to solve (0 = empty).
+ * @param count Number of boards.
+ * @param solved Receives, per board, whether it was solved; may be nullptr.
+ * @param fallback Engine used for boards that propagation alone does not finish.
+ * @return Number of boards solved.
+ *
+ * Example:
+ * @code
+ * vector<Board> boards = ...;
+ * vector<bool> solved;
+ * int n = solveBatch(boards, solved);
+ * @endcode
+ */
+int solveBatch(Board* boards, const int& count, bool* solved, const SolverType& fallback = SolverType::BITMASK);
+
+/**
+ * @brief `solveBatch()` that also adds search statistics to `stats` (see solver_stats.h).
+ *
+ * Each propagation round over one batch counts as one propagation step; boards finished by
+ * the fallback engine add that engine's nodes and backtracks.
+ */
+int solveBatch(Board* boards, const int& count, bool* solved, const SolverType& fallback, SolverStats& stats);
+
+/**
+ * @brief Budgeted `solveBatch()`: boards whose search runs over `budget` are reported, not waited for.
+ *
+ * Propagation always runs to the end; `budget` bounds the fallback search of every board on its
+ * own (each gets the full node budget, the deadline and token are shared by the whole call).
+ * Boards that are not `SOLVED` are restored to their input.
+ *
+ * With a `cache`, every board is first looked up by its canonical form and only misses are
+ * solved; their solutions are stored for later calls.
+ *
+ * @param boards Boards to solve (0 = empty).
+ * @param count Number of boards.
+ * @param status Receives, per board, SOLVED, UNSOLVABLE or BUDGET_EXCEEDED; must hold `count` entries.
+ * @param fallback Engine used for boards that propagation alone does not finish.
+ * @param budget Limits of each fallback search.
+ * @param stats Receives the search statistics.
+ * @param cache Solution cache to consult and fill; may be nullptr.
+ * @return Number of boards solved.
+ */
+int solveBatch(Board* boards, const int& count, SolveStatus* status, const SolverType& fallback,
+               const SolveBudget& budget, SolverStats& stats, SolutionCache* cache = nullptr);
+
+/**
+ * @brief Checks `count` solved boards, `BATCH_LANES` at a time, like `checkIfSolutionIsValid()`.
+ *
+ * Each of the 27 unit checks ORs the digit bits of nine cells for a whole batch per instruction.
+ *
+ * @param boards Boards to check.
+ * @param count Number of boards.
+ * @param valid Receives, per board, whether it is a complete and valid solution.
+ * @return Number of valid boards.
+ */
+int validateBatch(const Board* boards, const int& count, bool* valid);
+
+/**
+ * @brief `vector` overload of `solveBatch()`; `solved` is resized to `boards.size()`.
+ */
+int solveBatch(vector<Board>& boards, vector<bool>& solved, const SolverType& fallback = SolverType::BITMASK);
+
+#endif //SUDOKUPROJECT_BATCH_SOLVER_H
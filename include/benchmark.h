@@ -0,0 +1,144 @@
+/**
+ * @file benchmark.h
+ * @brief Reproducible benchmark harness for the solver engines.
+ *
+ * Unlike `compareSudokuSolvers()`, which times one fresh random board per iteration, the
+ * harness builds fixed corpora from a seed once and runs every selected engine over the
+ * same boards:
+ * - easy:     30 blanks, unique solution.
+ * - medium:   45 blanks, unique solution.
+ * - hard:     as many blanks as uniqueness allows, plus well-known hard puzzles.
+ * - 17-clue:  minimal puzzles with 17 givens.
+ *
+ * `solveBatch()` is measured as an extra "batch" engine; its latency is the time of each
+ * batch divided by the boards in it.
+ *
+ * Each run warms up, optionally pins itself to one CPU, and reports min / median / p99 / max
+ * latency and puzzles per second as a text table, JSON or CSV so results can be compared
+ * between releases. A separate untimed pass collects search statistics (nodes, backtracks,
+ * maximum depth, propagation steps) so counting never affects the latencies.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_BENCHMARK_H
+#define SUDOKUPROJECT_BENCHMARK_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "board.h"
+#include "solver_stats.h"
+#include "sudoku.h"
+using namespace std;
+
+/**
+ * @brief A named, fixed set of puzzles.
+ */
+struct BenchmarkCorpus {
+    string name;
+    vector<Board> puzzles;
+};
+
+/**
+ * @brief Names of the standard corpora, in report order.
+ */
+const vector<string>& standardCorpusNames();
+
+/**
+ * @brief Builds one standard corpus ("easy", "medium", "hard" or "17-clue").
+ *
+ * The result depends only on `name`, `seed` and `size`.
+ *
+ * @param name Corpus name.
+ * @param seed Master seed for generated puzzles.
+ * @param size Number of puzzles.
+ * @param corpus Receives the corpus.
+ * @return false if `name` is not a standard corpus.
+ */
+bool buildStandardCorpus(const string& name, const uint64_t& seed, const int& size, BenchmarkCorpus& corpus);
+
+/**
+ * @brief Latency distribution of one engine over one corpus, in microseconds.
+ */
+struct LatencySummary {
+    int count = 0;
+    double min_us = 0;
+    double median_us = 0;
+    double p99_us = 0;
+    double max_us = 0;
+    double mean_us = 0;
+    double puzzles_per_sec = 0;
+};
+
+/**
+ * @brief Computes the summary of a set of per-puzzle latencies (microseconds).
+ */
+LatencySummary summarizeLatencies(vector<double> latencies_us);
+
+/**
+ * @brief Result of one (corpus, engine) pair.
+ */
+struct BenchmarkResult {
+    string corpus;
+    SolverType solver = SolverType::BITMASK;
+    bool batched = false;  // solveBatch() with `solver` as fallback; latency is per puzzle, amortised per batch
+    LatencySummary latency;
+    int failures = 0;  // Puzzles the engine did not solve correctly
+    SolverStats stats;  // Summed over the corpus; empty unless BenchmarkConfig::collect_stats
+};
+
+/**
+ * @brief Engine label used in reports: the solver name, or "batch" for `solveBatch()` runs.
+ */
+string resultEngineName(const BenchmarkResult& result);
+
+/**
+ * @brief What to run and how.
+ */
+struct BenchmarkConfig {
+    vector<SolverType> solvers{begin(ALL_SOLVER_TYPES), end(ALL_SOLVER_TYPES)};
+    vector<string> corpora = standardCorpusNames();
+    int corpus_size = 200;
+    int warmup = 20;          // Untimed solves per (corpus, engine) before measuring
+    uint64_t seed = 2025;
+    int cpu = -1;             // CPU to pin the benchmark thread to, -1 = no pinning
+    bool include_slow = false; // Also run the basic solver on the hard and 17-clue corpora
+    bool include_batch = true; // Also run solveBatch() over each corpus
+    bool collect_stats = true; // Untimed extra pass that fills BenchmarkResult::stats
+};
+
+/**
+ * @brief Runs each selected engine over each selected corpus.
+ *
+ * @param config What to run.
+ * @return One result per (corpus, engine) pair that was run.
+ */
+vector<BenchmarkResult> runBenchmark(const BenchmarkConfig& config);
+
+/**
+ * @brief Output formats for `writeBenchmarkReport()`.
+ */
+enum class ReportFormat { TEXT, JSON, CSV };
+
+/**
+ * @brief Parses "text", "json" or "csv".
+ */
+bool parseReportFormat(const string& name, ReportFormat& format);
+
+/**
+ * @brief Writes benchmark results in the requested format.
+ */
+void writeBenchmarkReport(const vector<BenchmarkResult>& results, const BenchmarkConfig& config, const ReportFormat& format, ostream& out);
+
+/**
+ * @brief Pins the calling thread to one CPU (Linux only; a no-op returning false elsewhere).
+ */
+bool pinCurrentThread(const int& cpu);
+
+#endif //SUDOKUPROJECT_BENCHMARK_H
@@ -0,0 +1,55 @@
+/**
+ * @file bitops.h
+ * @brief Small bit-manipulation helpers shared by the mask-based solver engines.
+ *
+ * Digits are stored as 9-bit masks where bit (k - 1) stands for digit k, and
+ * cell sets are stored as 81-bit sets split over two 64-bit words.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_BITOPS_H
+#define SUDOKUPROJECT_BITOPS_H
+
+#include <cstdint>
+
+const uint16_t ALL_DIGITS = 0x1FF;  // Bits 0..8 represent digits 1..9
+
+/**
+ * @brief Number of set bits in a digit mask.
+ */
+inline int countBits(const uint32_t& mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcount(mask);
+#else
+    int count = 0;
+    for (uint32_t m = mask; m; m &= m - 1) count++;
+    return count;
+#endif
+}
+
+/**
+ * @brief Index of the lowest set bit of a non-zero mask.
+ */
+inline int lowestBit(const uint64_t& mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(mask);
+#else
+    int bit = 0;
+    while (!(mask & (uint64_t(1) << bit))) bit++;
+    return bit;
+#endif
+}
+
+/**
+ * @brief Converts a single-bit digit mask back to its digit (1..9).
+ */
+inline int bitToDigit(const uint16_t& bit) {
+    return lowestBit(bit) + 1;
+}
+
+#endif //SUDOKUPROJECT_BITOPS_H
@@ -0,0 +1,79 @@
+/**
+ * @file board.h
+ * @brief Flat, value-type representation of a 9x9 Sudoku board.
+ *
+ * This header defines the `Board` type used by the solver, generator and I/O hot paths:
+ * - 81 contiguous `uint8_t` cells stored row-major (`r * 9 + c`), 0 = empty.
+ * - Trivially copyable, so copying a board is a single 81-byte memcpy.
+ * - No heap allocation, so millions of boards can live on the stack or in flat arrays.
+ *
+ * It also provides the adapters between `Board` and the legacy `int**` boards
+ * returned by `getEmptyBoard()`, `generateBoard()` and `readSudokuFromFile()`.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_BOARD_H
+#define SUDOKUPROJECT_BOARD_H
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief A 9x9 Sudoku board stored as 81 contiguous cells.
+ *
+ * Cells are addressed either by flat index (`cells[r * 9 + c]`) or through `operator()(r, c)`.
+ * Value-initialising a board (`Board board{};`) yields an empty grid.
+ *
+ * Example:
+ * @code
+ * Board board{};
+ * board(0, 0) = 5;
+ * Board copy = board;   // 81-byte copy, no allocation
+ * @endcode
+ */
+struct Board {
+    uint8_t cells[81];
+
+    uint8_t& operator()(const int& r, const int& c) { return cells[r * 9 + c]; }
+    const uint8_t& operator()(const int& r, const int& c) const { return cells[r * 9 + c]; }
+
+    bool operator==(const Board& other) const { return std::memcmp(cells, other.cells, sizeof(cells)) == 0; }
+    bool operator!=(const Board& other) const { return !(*this == other); }
+};
+
+static_assert(sizeof(Board) == 81, "Board must be exactly 81 contiguous cells");
+static_assert(std::is_trivially_copyable<Board>::value, "Board must be trivially copyable");
+
+/**
+ * @brief Copies a legacy `int**` board into a flat `Board`.
+ *
+ * @param BOARD A 9x9 Sudoku board represented as a pointer-to-pointer (`int**`).
+ * @return Board The same grid as a flat value.
+ */
+Board toBoard(int** BOARD);
+
+/**
+ * @brief Writes the cells of a flat `Board` back into an existing `int**` board.
+ *
+ * @param board The source board.
+ * @param BOARD A 9x9 `int**` board that receives the values (must already be allocated).
+ */
+void copyToBoard(const Board& board, int** BOARD);
+
+/**
+ * @brief Allocates a new `int**` board holding the cells of a flat `Board`.
+ *
+ * The returned board must be released with `deallocateBoard()`.
+ *
+ * @param board The source board.
+ * @return int** A dynamically allocated 9x9 board.
+ */
+int** toIntBoard(const Board& board);
+
+#endif //SUDOKUPROJECT_BOARD_H
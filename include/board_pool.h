@@ -0,0 +1,76 @@
+/**
+ * @file board_pool.h
+ * @brief Per-thread pool of legacy `int**` boards.
+ *
+ * `getEmptyBoard()`, and through it `toIntBoard()`, `generateBoard()`, `readSudokuFromFile()`
+ * and `deepCopyBoard()`, draw their boards from here, and `deallocateBoard()` hands them back,
+ * so a loop that creates and frees a board per puzzle stops calling the allocator once the
+ * pool is warm:
+ * - A pooled board is a single block holding the 9 row pointers followed by the 81 cells,
+ *   instead of 10 separate allocations.
+ * - Every thread keeps its own free list, so there is no lock; a board released on another
+ *   thread than the one that acquired it simply joins that thread's list.
+ * - At most `BOARD_POOL_CAPACITY` free boards are kept per thread; the rest are freed, and a
+ *   thread's free boards are freed when it exits.
+ *
+ * The row pointers of a pooled board must not be reassigned: that is how `deallocateBoard()`
+ * tells it apart from a board built row by row with `new`, which it still frees the old way.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_BOARD_POOL_H
+#define SUDOKUPROJECT_BOARD_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Maximum number of free boards each thread keeps for reuse.
+ */
+const size_t BOARD_POOL_CAPACITY = 256;
+
+/**
+ * @brief Allocation counters of the calling thread's pool.
+ */
+struct BoardPoolStats {
+    uint64_t allocated = 0;  // Boards taken from the heap
+    uint64_t reused = 0;     // Boards handed out from the free list
+    size_t cached = 0;       // Free boards currently held
+};
+
+/**
+ * @brief Returns an empty (all 0) 9x9 board from the calling thread's pool.
+ *
+ * Example:
+ * @code
+ * int** board = acquireBoard();
+ * board[4][4] = 5;
+ * releaseBoard(board);  // board == nullptr; its storage is reused by the next acquireBoard()
+ * @endcode
+ */
+int** acquireBoard();
+
+/**
+ * @brief Hands a board obtained from `acquireBoard()` back to the calling thread's pool.
+ *
+ * @param BOARD The board; set to nullptr if it was pooled.
+ * @return false, leaving `BOARD` untouched, if it is nullptr or was not allocated by the pool.
+ */
+bool releaseBoard(int**& BOARD);
+
+/**
+ * @brief true if `BOARD` has the single-block layout of a pooled board.
+ */
+bool isPooledBoard(int** BOARD);
+
+/**
+ * @brief Counters of the calling thread's pool.
+ */
+BoardPoolStats boardPoolStats();
+
+#endif //SUDOKUPROJECT_BOARD_POOL_H
@@ -0,0 +1,179 @@
+/**
+ * @file board_sink.h
+ * @brief Buffered output sinks for writing many boards without per-board string building.
+ *
+ * Boards are formatted straight into fixed-size character buffers (no `to_string`, no
+ * `string +=`), and every sink reuses its buffers across writes:
+ * - `DirectorySink`: one grid-layout text file per board, named by `getFileName()`.
+ * - `StreamSink`:    all boards into one file or stdout, in grid or line layout, through a
+ *                    large output buffer that is flushed in batches.
+ * - `CorpusSink`:    records of a binary corpus (see corpus.h).
+ *
+ * `write(index, board)` is thread-safe on every sink. `StreamSink` additionally restores
+ * index order, so parallel workers can hand it boards as they finish; every index that is not
+ * written must then be passed to `skip(index)`, or the boards after it are held back.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_BOARD_SINK_H
+#define SUDOKUPROJECT_BOARD_SINK_H
+
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+#include "board.h"
+#include "corpus.h"
+using namespace std;
+
+const int GRID_TEXT_SIZE = 251;  // Bytes of one board in the grid layout of boardToString()
+const int LINE_TEXT_SIZE = 82;   // 81 cells plus '\n'
+
+/**
+ * @brief Formats a board in the grid layout of `boardToString()` into `out`.
+ *
+ * @param board The board to format.
+ * @param out Buffer of at least `GRID_TEXT_SIZE` bytes (not NUL-terminated).
+ * @return int The number of bytes written (always `GRID_TEXT_SIZE`).
+ */
+int formatBoardGrid(const Board& board, char* out);
+
+/**
+ * @brief Formats a board as one 81-character line (`.` for blanks) followed by '\n'.
+ *
+ * @param board The board to format.
+ * @param out Buffer of at least `LINE_TEXT_SIZE` bytes (not NUL-terminated).
+ * @return int The number of bytes written (always `LINE_TEXT_SIZE`).
+ */
+int formatBoardLine(const Board& board, char* out);
+
+/**
+ * @brief Text layouts supported by `StreamSink`.
+ */
+enum class TextLayout { GRID, LINE };
+
+/**
+ * @brief Destination for a numbered sequence of boards.
+ */
+class BoardSink {
+public:
+    virtual ~BoardSink() = default;
+
+    /**
+     * @brief Stores board number `index`.
+     *
+     * @return true if the board was accepted (it may still sit in a buffer until `flush()`).
+     */
+    virtual bool write(const int& index, const Board& board) = 0;
+
+    /**
+     * @brief Records that board `index` will never be written (e.g. an unsolvable puzzle).
+     *
+     * Sinks that keep index order must not wait for it; sinks that store boards by index need
+     * do nothing, which is the default.
+     */
+    virtual void skip(const int& index) { (void) index; }
+
+    /**
+     * @brief Pushes buffered output to its destination.
+     */
+    virtual bool flush() = 0;
+
+    /**
+     * @brief Human-readable location of board `index`, used in log lines.
+     */
+    virtual string describe(const int& index) const = 0;
+};
+
+/**
+ * @brief Writes each board to its own grid-layout file `getFileName(index, destination, prefix)`.
+ */
+class DirectorySink : public BoardSink {
+public:
+    DirectorySink(const string& destination, const string& prefix) : destination(destination), prefix(prefix) {}
+
+    bool write(const int& index, const Board& board) override;
+    bool flush() override { return true; }
+    string describe(const int& index) const override;
+
+private:
+    string destination;
+    string prefix;
+};
+
+/**
+ * @brief Writes every board into one file (or stdout) through a large reusable buffer.
+ *
+ * Boards are emitted in index order starting at 0; a board that arrives early is parked
+ * until all lower indexes have been written.
+ */
+class StreamSink : public BoardSink {
+public:
+    /**
+     * @param path Output file, or "-" for stdout.
+     * @param layout GRID (as in text puzzle files) or LINE (81 characters per board).
+     * @param buffer_size Bytes buffered before an automatic flush.
+     */
+    explicit StreamSink(const string& path, const TextLayout& layout = TextLayout::LINE, const size_t& buffer_size = 1 << 20);
+    ~StreamSink() override;
+
+    bool isOpen() const { return out != nullptr; }
+    bool write(const int& index, const Board& board) override;
+    void skip(const int& index) override;  // Later boards are not held back for `index`
+    bool flush() override;
+    string describe(const int& index) const override;
+
+private:
+    string path;
+    TextLayout layout;
+    FILE* out = nullptr;
+    bool owns_file = false;
+    vector<char> buffer;
+    size_t used = 0;
+    int next_index = 0;
+    map<int, Board> parked;  // Boards that arrived before their predecessors
+    set<int> skipped;        // Indexes that will never arrive
+    mutex lock;
+
+    bool emit(const Board& board);
+    bool flushLocked();
+    void drainLocked();
+};
+
+/**
+ * @brief Stores boards as records of a binary corpus; record `index` holds board `index`.
+ */
+class CorpusSink : public BoardSink {
+public:
+    CorpusSink(const string& path, const CorpusHeader& params);
+    ~CorpusSink() override;
+
+    bool isOpen() const { return open; }
+    bool write(const int& index, const Board& board) override { return open && writer.write(index, board); }
+    bool flush() override { return true; }
+    string describe(const int& index) const override;
+
+    /**
+     * @brief Pads the corpus with all-zero records up to `count` boards (see `CorpusWriter::padTo()`).
+     */
+    bool padTo(const int& count) { return open && writer.padTo(static_cast<uint64_t>(count)); }
+
+    /**
+     * @brief Finalizes the corpus header. Called automatically by the destructor.
+     */
+    bool close();
+
+private:
+    string path;
+    CorpusWriter writer;
+    bool open = false;
+};
+
+#endif //SUDOKUPROJECT_BOARD_SINK_H
@@ -0,0 +1,89 @@
+/**
+ * @file canonical.h
+ * @brief Canonical form of a Sudoku board under the validity-preserving symmetries.
+ *
+ * These transforms map puzzles to puzzles with the same number of solutions:
+ * - Transposition.
+ * - Permuting the three bands, and the three rows within every band.
+ * - Permuting the three stacks, and the three columns within every stack.
+ * - Relabelling the digits.
+ *
+ * `canonicalForm()` maps every board of one such orbit onto the same representative, together
+ * with the transform that produced it, so a solution found for the representative can be mapped
+ * back to any member with `untransformBoard()`.
+ *
+ * The representative is the lexicographically smallest board (row-major, 0 = empty first, digits
+ * relabelled in order of first appearance) among the transforms that order bands, rows, stacks
+ * and columns by invariants of their givens (how many, per block, and on which crossing lines).
+ * The invariants do not change under the symmetries, so the result is the same for every member
+ * of an orbit while only the few transforms that tie on them have to be compared. Very regular
+ * boards with more than `CANONICAL_SEARCH_LIMIT` tied arrangements are returned unchanged with
+ * the identity transform instead.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_CANONICAL_H
+#define SUDOKUPROJECT_CANONICAL_H
+
+#include <cstdint>
+#include "board.h"
+
+/**
+ * @brief Maximum number of tied row x column arrangements `canonicalForm()` compares.
+ */
+const int CANONICAL_SEARCH_LIMIT = 4096;
+
+/**
+ * @brief One symmetry: cell (i, j) of the result is `digits[source(rows[i], cols[j])]`,
+ *        where `source` is the input, transposed first if `transpose` is set.
+ */
+struct BoardTransform {
+    bool transpose = false;
+    uint8_t rows[9] = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    uint8_t cols[9] = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+    uint8_t digits[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};  // digits[0] stays 0
+};
+
+/**
+ * @brief A canonical representative and the transform that maps the input onto it.
+ */
+struct CanonicalBoard {
+    Board board;
+    BoardTransform transform;
+    bool exact = true;  // false if the search limit was hit and `board` is the input itself
+};
+
+/**
+ * @brief Applies `transform` to `input`.
+ */
+void transformBoard(const Board& input, const BoardTransform& transform, Board& output);
+
+/**
+ * @brief Applies the inverse of `transform`: `untransformBoard(transformBoard(b)) == b`.
+ */
+void untransformBoard(const Board& input, const BoardTransform& transform, Board& output);
+
+/**
+ * @brief Computes the canonical representative of a board's symmetry class.
+ *
+ * @param board The board (0 = empty); it does not need to be valid.
+ * @param form Receives the representative and the transform from `board` to it.
+ * @return `form.exact`.
+ *
+ * Example:
+ * @code
+ * CanonicalBoard form;
+ * canonicalForm(puzzle, form);
+ * solve(form.board, SolverType::DLX);
+ * Board solution;
+ * untransformBoard(form.board, form.transform, solution);  // Solves `puzzle`
+ * @endcode
+ */
+bool canonicalForm(const Board& board, CanonicalBoard& form);
+
+#endif //SUDOKUPROJECT_CANONICAL_H
@@ -0,0 +1,254 @@
+/**
+ * @file cell_selection.h
+ * @brief Incremental candidate tracking and pluggable cell-selection policies.
+ *
+ * `findNextCell()` recomputes the option count of every empty cell with `isValid()` on
+ * every recursion step. This header provides a `CandidateTracker` that keeps:
+ * - Row, column and box usage masks (bit (k - 1) set = digit k used).
+ * - The remaining-candidate count of every open cell.
+ * - One 81-bit bucket per count (0..9) holding the open cells with that many candidates.
+ *
+ * All of it is updated when a digit is placed or removed, touching only the 20 peers of
+ * the cell. A selection policy then picks the next cell from the tracker, e.g.
+ * `MrvSelection` takes any cell from the lowest non-empty bucket in near-constant time.
+ *
+ * Policies are plain structs with a static `select()` member, so new heuristics can be
+ * tried by writing a struct and calling `solveBoardWithSelection<MyPolicy>(board)`.
+ *
+ * The search is iterative: one fixed 81-entry stack of frames replaces the recursion, so the
+ * whole state of a solve lives in plain arrays and no call is made per placement.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_CELL_SELECTION_H
+#define SUDOKUPROJECT_CELL_SELECTION_H
+
+#include <cstdint>
+#include "board.h"
+#include "bitops.h"
+#include "geometry.h"
+#include "solver_stats.h"
+
+/**
+ * @brief Tracks candidate masks, per-cell candidate counts and count buckets of a board.
+ */
+class CandidateTracker {
+public:
+    /**
+     * @brief Loads the givens of a board.
+     *
+     * @param BOARD The board to track; 0 = empty.
+     * @return false if two givens conflict (the board is unsolvable), true otherwise.
+     */
+    bool init(const Board& BOARD);
+
+    /**
+     * @brief Places `digit` at `cell`, updating the masks and the buckets of its open peers.
+     */
+    void place(const int& cell, const int& digit) {
+        const PeerTable& table = PEER_TABLE;
+        uint16_t bit = 1u << (digit - 1);
+        removeOpen(cell);
+        for (int i = 0; i < 20; i++) {
+            int peer = table.peers[cell][i];
+            if (isOpen(peer) && (candidates(peer) & bit)) move(peer, counts[peer] - 1);
+        }
+        rows[table.row[cell]] |= bit;
+        cols[table.col[cell]] |= bit;
+        boxes[table.box[cell]] |= bit;
+    }
+
+    /**
+     * @brief Reverts `place(cell, digit)`.
+     */
+    void unplace(const int& cell, const int& digit) {
+        const PeerTable& table = PEER_TABLE;
+        uint16_t bit = 1u << (digit - 1);
+        rows[table.row[cell]] &= ~bit;
+        cols[table.col[cell]] &= ~bit;
+        boxes[table.box[cell]] &= ~bit;
+        for (int i = 0; i < 20; i++) {
+            int peer = table.peers[cell][i];
+            if (isOpen(peer) && (candidates(peer) & bit)) move(peer, counts[peer] + 1);
+        }
+        addOpen(cell, countBits(candidates(cell)));
+    }
+
+    /**
+     * @brief Digits that can still be placed at `cell`, as a 9-bit mask.
+     */
+    uint16_t candidates(const int& cell) const {
+        const PeerTable& table = PEER_TABLE;
+        return ALL_DIGITS & ~(rows[table.row[cell]] | cols[table.col[cell]] | boxes[table.box[cell]]);
+    }
+
+    bool isOpen(const int& cell) const { return (open[cell >> 6] >> (cell & 63)) & 1; }
+    int count(const int& cell) const { return counts[cell]; }
+    bool hasOpenCells() const { return (open[0] | open[1]) != 0; }
+
+    /**
+     * @brief Lowest-index open cell, or -1 if the board is full.
+     */
+    int firstOpen() const { return firstIn(open); }
+
+    /**
+     * @brief Lowest-index open cell with exactly `n` candidates, or -1 if there is none.
+     */
+    int firstWithCount(const int& n) const { return firstIn(buckets[n]); }
+
+private:
+    uint16_t rows[9];
+    uint16_t cols[9];
+    uint16_t boxes[9];
+    uint8_t counts[81];
+    uint64_t buckets[10][2];
+    uint64_t open[2];
+
+    static int firstIn(const uint64_t set[2]) {
+        if (set[0]) return lowestBit(set[0]);
+        if (set[1]) return 64 + lowestBit(set[1]);
+        return -1;
+    }
+
+    void addOpen(const int& cell, const int& n) {
+        uint64_t bit = uint64_t(1) << (cell & 63);
+        open[cell >> 6] |= bit;
+        buckets[n][cell >> 6] |= bit;
+        counts[cell] = static_cast<uint8_t>(n);
+    }
+
+    void removeOpen(const int& cell) {
+        uint64_t bit = uint64_t(1) << (cell & 63);
+        open[cell >> 6] &= ~bit;
+        buckets[counts[cell]][cell >> 6] &= ~bit;
+    }
+
+    void move(const int& cell, const int& n) {
+        uint64_t bit = uint64_t(1) << (cell & 63);
+        buckets[counts[cell]][cell >> 6] &= ~bit;
+        buckets[n][cell >> 6] |= bit;
+        counts[cell] = static_cast<uint8_t>(n);
+    }
+};
+
+/**
+ * @brief Minimum Remaining Value: the first cell of the lowest non-empty bucket.
+ *
+ * A cell with 0 candidates is returned first so the search backtracks immediately.
+ */
+struct MrvSelection {
+    static int select(const CandidateTracker& tracker) {
+        for (int n = 0; n <= 9; n++) {
+            int cell = tracker.firstWithCount(n);
+            if (cell >= 0) return cell;
+        }
+        return -1;
+    }
+};
+
+/**
+ * @brief Row-major order, like `solveBoard()`; useful as a baseline for experiments.
+ */
+struct FirstEmptySelection {
+    static int select(const CandidateTracker& tracker) {
+        return tracker.firstOpen();
+    }
+};
+
+namespace detail {
+    /**
+     * @brief One level of the explicit search stack: the cell, its untried digits and the digit on the board.
+     */
+    struct SelectionFrame {
+        int cell;
+        uint16_t options;
+        int digit;  // 0 = nothing placed at this level yet
+    };
+
+    template <typename SelectionPolicy, typename Recorder>
+    bool searchWithSelection(Board& BOARD, CandidateTracker& tracker, Recorder& recorder) {
+        // Every level places one digit into one of at most 81 open cells, so the stack never overflows
+        SelectionFrame stack[81];
+        int depth = 0;
+        bool descend = true;
+        while (true) {
+            if (descend) {
+                uint64_t start = recorder.clock();
+                int cell = SelectionPolicy::select(tracker);
+                recorder.addSelection(start);
+                if (cell < 0) return true;  // No open cells left, the board is solved
+                stack[depth] = SelectionFrame{cell, tracker.candidates(cell), 0};
+                descend = false;
+            }
+
+            SelectionFrame& frame = stack[depth];
+            if (frame.digit != 0) {
+                uint64_t start = recorder.clock();
+                tracker.unplace(frame.cell, frame.digit);
+                recorder.addPlacement(start);
+                recorder.backtrack();
+                frame.digit = 0;
+            }
+            if (frame.options == 0) {
+                BOARD.cells[frame.cell] = 0;
+                if (depth == 0) return false;
+                depth--;
+                continue;
+            }
+
+            if (recorder.stop()) return false;  // Budget used up; the caller restores the board
+            uint16_t bit = frame.options & (~frame.options + 1);  // Isolate lowest set bit
+            frame.options &= frame.options - 1;
+            frame.digit = bitToDigit(bit);
+
+            recorder.node(depth + 1);
+            uint64_t start = recorder.clock();
+            tracker.place(frame.cell, frame.digit);
+            BOARD.cells[frame.cell] = static_cast<uint8_t>(frame.digit);
+            recorder.addPlacement(start);
+            depth++;
+            descend = true;
+        }
+    }
+}
+
+/**
+ * @brief Backtracking solver that picks cells through `SelectionPolicy` on an incremental tracker.
+ *
+ * @tparam SelectionPolicy A struct with `static int select(const CandidateTracker&)` returning the
+ *         next open cell (r * 9 + c) or -1 when the board is full.
+ * @tparam Recorder A recorder from solver_stats.h; `NullRecorder` records nothing at no cost.
+ * @param BOARD 9x9 Sudoku board (modified in-place)
+ * @param recorder Receives node, backtrack and timing events
+ * @return true if solved, false if unsolvable
+ *
+ * Example:
+ * @code
+ * Board board = ...;
+ * SolverStats stats;
+ * CountingRecorder recorder(stats);
+ * solveBoardWithSelection<MrvSelection>(board, recorder);
+ * @endcode
+ */
+template <typename SelectionPolicy, typename Recorder>
+bool solveBoardWithSelection(Board& BOARD, Recorder& recorder) {
+    CandidateTracker tracker;
+    if (!tracker.init(BOARD)) return false;
+    return detail::searchWithSelection<SelectionPolicy>(BOARD, tracker, recorder);
+}
+
+/**
+ * @brief `solveBoardWithSelection()` without statistics.
+ */
+template <typename SelectionPolicy>
+bool solveBoardWithSelection(Board& BOARD) {
+    NullRecorder recorder;
+    return solveBoardWithSelection<SelectionPolicy>(BOARD, recorder);
+}
+
+#endif //SUDOKUPROJECT_CELL_SELECTION_H
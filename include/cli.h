@@ -0,0 +1,71 @@
+/**
+ * @file cli.h
+ * @brief Command-line front end: `generate`, `solve`, `bench`, `serve` and `compare`.
+ *
+ * Every mode of the project is reachable from one binary with flags, so experiments are
+ * scripted instead of recompiled:
+ *
+ * @code
+ * SudokuProject generate --count 100000 --blanks 55 --format corpus --output data/p.sdk --seed 7
+ * SudokuProject generate --count 500 --difficulty hard-expert --bank data/bank --stock 2000
+ * SudokuProject solve --input data/p.sdk --output data/s.sdk --workers 8 --shard 2/4
+ * SudokuProject solve --output data/s.sdk --merge 4
+ * SudokuProject generate --count 1000 --format line | SudokuProject solve --input - --format line
+ * SudokuProject bench --engines bitmask,dlx --format json
+ * SudokuProject serve --socket unix:/tmp/sudoku.sock --metrics-socket tcp:9100
+ * @endcode
+ *
+ * The `run*Command()` functions take the arguments after the command name; `SudokuBenchmark`
+ * and `SudokuService` are thin wrappers over `runBenchCommand()` and `runServeCommand()`.
+ * All of them return the process exit code: 0 on success, 1 if the work failed and 2 for
+ * a usage error; `solve` returns 3 when it ran but left puzzles unsolved or unwritten.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_CLI_H
+#define SUDOKUPROJECT_CLI_H
+
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * @brief Dispatches `argv[1]` to its command; prints the command list for no or unknown commands.
+ */
+int runCli(int argc, char** argv);
+
+/**
+ * @brief `generate`: puzzles by blank count or difficulty band into files, a stream or a corpus.
+ */
+int runGenerateCommand(const vector<string>& args);
+
+/**
+ * @brief `solve`: a puzzle folder, corpus or text stream, optionally one shard of it; or `--merge` the shards.
+ */
+int runSolveCommand(const vector<string>& args);
+
+/**
+ * @brief `bench`: the benchmark harness (see benchmark.h).
+ *
+ * @param program Shown in the usage text.
+ */
+int runBenchCommand(const vector<string>& args, const string& program = "SudokuProject bench");
+
+/**
+ * @brief `serve`: the solver service over stdin/stdout or a socket (see solver_service.h).
+ *
+ * @param program Shown in the usage text.
+ */
+int runServeCommand(const vector<string>& args, const string& program = "SudokuProject serve");
+
+/**
+ * @brief `compare`: times the solvers against each other with `compareSudokuSolvers()`.
+ */
+int runCompareCommand(const vector<string>& args);
+
+#endif //SUDOKUPROJECT_CLI_H
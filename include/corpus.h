@@ -0,0 +1,178 @@
+/**
+ * @file corpus.h
+ * @brief Packed binary corpus format for storing many Sudoku boards in one file.
+ *
+ * Storing every puzzle as its own text file costs one inode and one open/close per board.
+ * A corpus file instead holds a small fixed header followed by fixed-size records:
+ *
+ * @code
+ * offset 0   CorpusHeader (32 bytes, little-endian)
+ * offset 32  record 0: 81 cells x 4 bits = 41 bytes (cell 2i in the low nibble of byte i)
+ * offset 73  record 1
+ * ...
+ * @endcode
+ *
+ * `CorpusReader` memory-maps the file, so reading board i is a 41-byte unpack with no
+ * system call. `CorpusWriter` creates or extends a corpus and can write records by index,
+ * which lets parallel workers store puzzle i at record i regardless of completion order.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_CORPUS_H
+#define SUDOKUPROJECT_CORPUS_H
+
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include "board.h"
+using namespace std;
+
+const uint32_t CORPUS_MAGIC = 0x434B4453;   // "SDKC" in file order
+const uint16_t CORPUS_VERSION = 1;
+const uint16_t CORPUS_RECORD_SIZE = 41;     // 81 cells x 4 bits, rounded up
+const uint32_t CORPUS_FLAG_SOLVED = 1u << 0;  // Records are solutions rather than puzzles
+const uint32_t CORPUS_FLAG_UNIQUE = 1u << 1;  // Puzzles were generated with GenerationMode::UNIQUE
+const uint32_t CORPUS_FLAG_RATED = 1u << 2;   // Every record has the grade the file is named after (see puzzle_bank.h)
+
+/**
+ * @brief Fixed 32-byte header at the start of every corpus file.
+ */
+struct CorpusHeader {
+    uint32_t magic = CORPUS_MAGIC;
+    uint16_t version = CORPUS_VERSION;
+    uint16_t record_size = CORPUS_RECORD_SIZE;
+    uint64_t count = 0;         // Number of records in the file
+    int32_t empty_boxes = 0;    // Generation parameter: requested blanks per puzzle (0 = unknown)
+    uint32_t flags = 0;         // CORPUS_FLAG_* bits
+    uint64_t master_seed = 0;   // Generation parameter: seed passed to derivePuzzleSeed()
+};
+
+static_assert(sizeof(CorpusHeader) == 32, "CorpusHeader must stay 32 bytes");
+
+/**
+ * @brief Packs a board into a 41-byte record (4 bits per cell).
+ */
+void packBoard(const Board& board, uint8_t* record);
+
+/**
+ * @brief Unpacks a 41-byte record into a board.
+ *
+ * @return false if a cell holds a value above 9 (corrupt record), true otherwise.
+ */
+bool unpackBoard(const uint8_t* record, Board& board);
+
+/**
+ * @brief Read-only, memory-mapped view of a corpus file.
+ *
+ * Example:
+ * @code
+ * CorpusReader reader;
+ * if (reader.open("data/puzzles.sdk")) {
+ *     Board board;
+ *     for (uint64_t i = 0; i < reader.size(); i++) reader.read(i, board);
+ * }
+ * @endcode
+ */
+class CorpusReader {
+public:
+    CorpusReader() = default;
+    ~CorpusReader();
+    CorpusReader(const CorpusReader&) = delete;
+    CorpusReader& operator=(const CorpusReader&) = delete;
+
+    /**
+     * @brief Maps a corpus file and validates its header.
+     *
+     * @param path Path of the corpus file.
+     * @return true on success; false (with a message on cerr) if the file is missing or malformed.
+     */
+    bool open(const string& path);
+
+    /**
+     * @brief Unmaps the file. Called automatically by the destructor.
+     */
+    void close();
+
+    const CorpusHeader& header() const { return head; }
+    uint64_t size() const { return head.count; }
+
+    /**
+     * @brief Unpacks record `index` into `board`. Safe to call from several threads.
+     *
+     * @return false if `index` is out of range or the record is corrupt.
+     */
+    bool read(const uint64_t& index, Board& board) const;
+
+private:
+    CorpusHeader head;
+    const uint8_t* data = nullptr;  // Start of the mapping (header included)
+    size_t length = 0;
+    bool mapped = false;            // false when the fallback buffer is used instead of mmap
+};
+
+/**
+ * @brief Creates or appends to a corpus file.
+ *
+ * Records can be appended in order with `append()` or stored at a given index with `write()`;
+ * both are thread-safe. The record count in the header is updated by `close()`.
+ */
+class CorpusWriter {
+public:
+    CorpusWriter() = default;
+    ~CorpusWriter();
+    CorpusWriter(const CorpusWriter&) = delete;
+    CorpusWriter& operator=(const CorpusWriter&) = delete;
+
+    /**
+     * @brief Opens `path` for writing.
+     *
+     * If the file already is a corpus, new records are appended after the existing ones and
+     * its header parameters are kept; otherwise a new file is created with `params`.
+     *
+     * @param path Path of the corpus file.
+     * @param params Header parameters for a new file (`count` is ignored).
+     * @return true on success.
+     */
+    bool open(const string& path, const CorpusHeader& params);
+
+    /**
+     * @brief Appends a record after the last one written so far.
+     */
+    bool append(const Board& board);
+
+    /**
+     * @brief Stores a record at `index` relative to the first record added by this writer.
+     */
+    bool write(const uint64_t& index, const Board& board);
+
+    /**
+     * @brief Appends all-zero records until `count` records follow the first one added by this writer.
+     *
+     * Records never written in the middle of the range already read back as zero; this extends
+     * the range past the last written record, e.g. when the last puzzles of a batch failed.
+     */
+    bool padTo(const uint64_t& count);
+
+    /**
+     * @brief Writes the final record count into the header and closes the file.
+     */
+    bool close();
+
+    uint64_t size() const { return head.count; }
+
+private:
+    CorpusHeader head;
+    FILE* file = nullptr;
+    uint64_t base = 0;  // Records that were already in the file when it was opened
+    std::mutex lock;
+
+    bool writeRecordAt(const uint64_t& position, const Board& board);
+};
+
+#endif //SUDOKUPROJECT_CORPUS_H
@@ -0,0 +1,76 @@
+/**
+ * @file deduction.h
+ * @brief Logical-deduction pre-pass and difficulty grading.
+ *
+ * Most generated puzzles can be finished without guessing. `deduce()` keeps a candidate
+ * mask per cell and repeatedly applies, cheapest first:
+ * - Naked singles: a cell with one candidate left gets that digit.
+ * - Hidden singles: a digit with one possible cell left in a row, column or box goes there.
+ * - Locked candidates: if a digit's candidates in a box lie on one row or column, it is
+ *   removed from the rest of that line ("pointing"); if its candidates in a line lie in one
+ *   box, it is removed from the rest of that box ("claiming").
+ *
+ * After any progress it starts again from naked singles. Whatever is left is handed to the
+ * search engine. The techniques that were needed give the puzzle's difficulty grade.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_DEDUCTION_H
+#define SUDOKUPROJECT_DEDUCTION_H
+
+#include "board.h"
+
+/**
+ * @brief Difficulty grade, by the hardest technique a puzzle needs.
+ *
+ * - EASY:    Naked singles only.
+ * - MEDIUM:  Hidden singles.
+ * - HARD:    Locked candidates.
+ * - EXPERT:  Not solvable by the techniques above; needs search.
+ * - INVALID: The givens lead to a contradiction.
+ */
+enum class Difficulty { EASY, MEDIUM, HARD, EXPERT, INVALID };
+
+/**
+ * @brief Lower-case name of a grade ("easy", "medium", "hard", "expert", "invalid").
+ */
+const char* difficultyName(const Difficulty& difficulty);
+
+/**
+ * @brief What `deduce()` did to a board.
+ */
+struct DeductionReport {
+    int naked_singles = 0;      // Digits placed as naked singles
+    int hidden_singles = 0;     // Digits placed as hidden singles
+    int locked_candidates = 0;  // Candidates removed by pointing / claiming
+    int open_cells = 0;         // Cells still empty afterwards
+    bool contradiction = false;
+    Difficulty difficulty = Difficulty::EASY;
+};
+
+/**
+ * @brief Fills every cell that logic alone determines.
+ *
+ * @param board 9x9 Sudoku board (0 = empty), modified in-place
+ * @param report Receives the technique counts and the difficulty grade
+ * @return false if the board is contradictory (it then has no solution), true otherwise
+ *
+ * Example:
+ * @code
+ * DeductionReport report;
+ * if (deduce(board, report) && report.open_cells > 0) solveBoardBitmask(board);
+ * @endcode
+ */
+bool deduce(Board& board, DeductionReport& report);
+
+/**
+ * @brief Grades a puzzle without modifying it.
+ */
+Difficulty gradeDifficulty(const Board& board);
+
+#endif //SUDOKUPROJECT_DEDUCTION_H
@@ -21,6 +21,46 @@
 #ifndef GENERATOR_H
 #define GENERATOR_H
 #include <vector>
+#include <random>
+#include <cstdint>
+#include "board.h"
+
+/**
+ * @brief Random engine used by every generator function that takes an explicit engine.
+ *
+ * Passing an engine instead of relying on global `rand()` makes generation thread-safe and,
+ * when the engine is seeded with `derivePuzzleSeed()`, reproducible per puzzle.
+ */
+typedef std::mt19937_64 RandomEngine;
+
+/**
+ * @brief How cells are blanked when turning a solved grid into a puzzle.
+ *
+ * - UNIQUE: Cells are removed one at a time and a removal is kept only if `countSolutions()`
+ *           still reports a single solution (default).
+ * - RANDOM: `empty_boxes` cells are blanked at random with no uniqueness check.
+ */
+enum class GenerationMode { UNIQUE, RANDOM };
+
+/**
+ * @brief Returns the calling thread's engine, seeded once from `std::random_device`.
+ *
+ * Used by the overloads that do not take an engine, so they no longer construct a
+ * `std::random_device` and a fresh Mersenne Twister on every call.
+ */
+RandomEngine& getThreadEngine();
+
+/**
+ * @brief Derives the seed of puzzle `index` from a master seed.
+ *
+ * The result depends only on `(master_seed, index)`, so a corpus generated with the same
+ * master seed is identical no matter how many threads produced it or in which order.
+ *
+ * @param master_seed Seed of the whole generation job.
+ * @param index Index of the puzzle inside the job.
+ * @return uint64_t Seed for that puzzle's `RandomEngine`.
+ */
+uint64_t derivePuzzleSeed(const uint64_t& master_seed, const int& index);
 
 
 /**
@@ -32,6 +72,8 @@
 * board to 0, which represents an empty Sudoku grid.
 *-@return int** A pointer to a 9x9 Sudoku board with all cells initialized to 0.
 * -The returned board is a **dynamically allocated 2D array**
+* -Boards come from the calling thread's board pool (see board_pool.h); `deallocateBoard()`
+*  returns them for reuse, so a steady generate/free loop does not hit the allocator.
 */
 int** getEmptyBoard();
 
@@ -50,6 +92,14 @@ int** getEmptyBoard();
  */
 std::vector<int> getShuffledVector();
 
+/**
+ * @brief Shuffles the numbers 1 to 9 with a caller-supplied engine.
+ *
+ * @param engine The random engine to draw from.
+ * @return std::vector<int> A shuffled vector containing numbers from 1 to 9.
+ */
+std::vector<int> getShuffledVector(RandomEngine& engine);
+
 
 /**
  * @brief Fills the diagonal 3x3 boxes of a Sudoku board with unique numbers from 1 to 9.
@@ -76,6 +126,16 @@ std::vector<int> getShuffledVector();
  */
 void fillBoardWithIndependentBox(int** BOARD);
 
+/**
+ * @brief `Board` overload of `fillBoardWithIndependentBox()`.
+ */
+void fillBoardWithIndependentBox(Board& BOARD);
+
+/**
+ * @brief `fillBoardWithIndependentBox()` drawing from a caller-supplied engine.
+ */
+void fillBoardWithIndependentBox(Board& BOARD, RandomEngine& engine);
+
 /**
  * @brief Deletes 'n' random cells from a 9x9 Sudoku board.
  *
@@ -100,6 +160,70 @@ void fillBoardWithIndependentBox(int** BOARD);
  */
 void deleteRandomItems(int** BOARD, const int& n);
 
+/**
+ * @brief `Board` overload of `deleteRandomItems()`.
+ *
+ * Draws from an engine seeded with `rand()`, so the cells it removes follow `srand()`.
+ */
+void deleteRandomItems(Board& BOARD, const int& n);
+
+/**
+ * @brief `deleteRandomItems()` drawing from a caller-supplied engine instead of global `rand()`.
+ *
+ * The cells come from `selectRandomCells()`, so removal is O(n) however close `n` is to 81, and the
+ * result is fully determined by the engine state. If the board has fewer than `n` filled cells, all
+ * of them are cleared.
+ */
+void deleteRandomItems(Board& BOARD, const int& n, RandomEngine& engine);
+
+/**
+ * @brief Picks `n` distinct filled cells in random order with a partial Fisher-Yates shuffle.
+ *
+ * Only the first `n` positions of the filled-cell list are shuffled, so each pick costs one engine
+ * draw and no pick is ever retried.
+ *
+ * @param BOARD The board whose filled cells (value != 0) are candidates.
+ * @param n How many cells to pick; pass 81 for a random order of every filled cell.
+ * @param cells Receives the picked cell indexes (r * 9 + c); must hold 81 entries.
+ * @param engine The random engine to draw from.
+ * @return int The number of cells picked: `n`, or fewer if the board has fewer filled cells.
+ */
+int selectRandomCells(const Board& BOARD, const int& n, int* cells, RandomEngine& engine);
+
+/**
+ * @brief Blanks up to `n` cells while keeping the puzzle's solution unique.
+ *
+ * Cells are visited in the order given by `selectRandomCells()`; each is blanked and restored again if the puzzle now
+ * has more than one solution (checked with `countSolutions(board, 2)`). Only a limited number
+ * of cells can be removed from a grid before every further removal breaks uniqueness (usually
+ * 55-60), so the result can have fewer than `n` blanks.
+ *
+ * @param BOARD A solved (or uniquely solvable) 9x9 board, modified in place.
+ * @param n The number of cells to delete (should be between 1 and 81).
+ * @param engine The random engine that decides the removal order.
+ * @return int The number of cells actually blanked.
+ */
+int deleteItemsKeepingUnique(Board& BOARD, const int& n, RandomEngine& engine);
+
+/**
+ * @brief Fills `BOARD` with a random complete (solved) grid.
+ *
+ * The diagonal boxes are filled with `fillBoardWithIndependentBox()`, then the rest of the grid is
+ * completed by a bitmask search that takes the cell with the fewest candidates first and tries its
+ * candidates in shuffled order. Any grid can come out, and a grid takes a few microseconds instead
+ * of a `solveBoard()` run that always prefers the smallest digit and can backtrack heavily.
+ *
+ * @param BOARD Receives the grid (previous contents are discarded).
+ * @param engine The random engine to draw from.
+ */
+void generateSolvedGrid(Board& BOARD, RandomEngine& engine);
+
+/**
+ * @brief `generateSolvedGrid()` drawing from the calling thread's engine.
+ */
+void generateSolvedGrid(Board& BOARD);
+
+
 /**
  * @brief Generates a solvable Sudoku board with a specified number of empty cells.
  *
@@ -110,17 +234,19 @@ void deleteRandomItems(int** BOARD, const int& n);
  * The process involves:
  * 1. Initializing an empty board.
  * 2. Filling the diagonal 3x3 boxes.
- * 3. Solving the board to complete it.
+ * 3. Completing the grid with a randomized search (`generateSolvedGrid()`).
  * 4. Randomly deleting the specified number of cells to generate the puzzle.
  *
  * The function ensures that the board remains solvable after deleting cells.
  *
  * @param empty_boxes The number of cells to be emptied in the generated puzzle (must be between 1 and 81).
+ * @param mode UNIQUE (default) only keeps removals that preserve a unique solution, so the puzzle can
+ *             end up with fewer blanks than requested; RANDOM blanks exactly `empty_boxes` cells.
  *
  * @return int** A dynamically allocated 9x9 Sudoku board with 'empty_boxes' empty cells.
  *
- * @note The function uses helper functions like `getEmptyBoard()`, `fillBoardWithIndependentBox()`,
- * `solveBoard()`, and `deleteRandomItems()` to perform its operations. It ensures that the puzzle
+ * @note The function uses helper functions like `getEmptyBoard()`, `generateSolvedGrid()`
+ * and `deleteRandomItems()` to perform its operations. It ensures that the puzzle
  * generated has a unique solution.
  *
  * Example:
@@ -129,6 +255,36 @@ void deleteRandomItems(int** BOARD, const int& n);
  * // The generated board will have 5 random cells set to 0.
  * @endcode
  */
-int** generateBoard(const int& empty_boxes);
+int** generateBoard(const int& empty_boxes, const GenerationMode& mode = GenerationMode::UNIQUE);
+
+/**
+ * @brief Generates a puzzle into a flat `Board` without any heap allocation.
+ *
+ * Same process as `generateBoard(empty_boxes)`; the `int**` version is a thin adapter over this one.
+ *
+ * @param BOARD Receives the generated puzzle (previous contents are discarded).
+ * @param empty_boxes The number of cells to be emptied in the generated puzzle (must be between 1 and 81).
+ */
+void generateBoard(Board& BOARD, const int& empty_boxes, const GenerationMode& mode = GenerationMode::UNIQUE);
+
+/**
+ * @brief Original generator: fills the grid, then blanks `empty_boxes` cells with global `rand()`.
+ *
+ * Honours `srand()`: the solved grid and the blanked cells both come from engines seeded with
+ * `rand()`, so runs seeded with `srand(0)` make the same puzzle every time.
+ * The puzzle may have more than one solution.
+ */
+void generateRandomBoard(Board& BOARD, const int& empty_boxes);
+
+/**
+ * @brief Generates a puzzle using only the given engine, so it is safe to call from several threads.
+ *
+ * With the engine seeded from `derivePuzzleSeed(master, i)` the puzzle is fully determined by `(master, i)`.
+ *
+ * @param BOARD Receives the generated puzzle.
+ * @param empty_boxes The number of cells to be emptied (must be between 1 and 81).
+ * @param engine The random engine to draw from.
+ */
+void generateBoard(Board& BOARD, const int& empty_boxes, RandomEngine& engine, const GenerationMode& mode = GenerationMode::UNIQUE);
 
 #endif // GENERATOR_H
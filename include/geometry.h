@@ -0,0 +1,102 @@
+/**
+ * @file geometry.h
+ * @brief Compile-time geometry tables of the 9x9 board: peers, units and the units of every cell.
+ *
+ * Every engine, the validator and the generator look up rows, columns, boxes and peers here
+ * instead of recomputing `3 * (r / 3)` box origins or scanning row, column and box in turn.
+ * The tables are `constexpr`, so they are built by the compiler, live in read-only data and
+ * need no start-up initialisation; an index into them is the only work left at run time.
+ *
+ * Cells are numbered r * 9 + c. Units are numbered rows 0..8, columns 9..17, boxes 18..26,
+ * with boxes numbered row-major like the cells.
+ *
+ * Other board orders use `BoardGeometry<BOX>` in sized_board.h.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_GEOMETRY_H
+#define SUDOKUPROJECT_GEOMETRY_H
+
+#include <cstdint>
+
+/**
+ * @brief The 20 peers (same row, column or box, excluding the cell itself) of every cell.
+ */
+struct PeerTable {
+    uint8_t peers[81][20];
+    uint8_t row[81];
+    uint8_t col[81];
+    uint8_t box[81];
+};
+
+/**
+ * @brief The 27 units as cell indexes: rows 0..8, columns 9..17, boxes 18..26.
+ */
+struct UnitTable {
+    uint8_t cells[27][9];
+    uint8_t of[81][3];  // Row, column and box unit of every cell, in that order
+};
+
+namespace detail {
+    constexpr PeerTable buildPeerTable() {
+        PeerTable table{};
+        for (int cell = 0; cell < 81; cell++) {
+            int r = cell / 9, c = cell % 9;
+            table.row[cell] = static_cast<uint8_t>(r);
+            table.col[cell] = static_cast<uint8_t>(c);
+            table.box[cell] = static_cast<uint8_t>(3 * (r / 3) + c / 3);
+        }
+        for (int cell = 0; cell < 81; cell++) {
+            int n = 0;
+            for (int other = 0; other < 81; other++) {
+                if (other == cell) continue;
+                if (table.row[other] == table.row[cell] || table.col[other] == table.col[cell] ||
+                    table.box[other] == table.box[cell]) {
+                    table.peers[cell][n++] = static_cast<uint8_t>(other);
+                }
+            }
+        }
+        return table;
+    }
+
+    constexpr UnitTable buildUnitTable() {
+        UnitTable table{};
+        for (int i = 0; i < 9; i++) {
+            for (int j = 0; j < 9; j++) {
+                table.cells[i][j] = static_cast<uint8_t>(i * 9 + j);                 // Row i
+                table.cells[9 + i][j] = static_cast<uint8_t>(j * 9 + i);             // Column i
+                int r = (i / 3) * 3 + j / 3, c = (i % 3) * 3 + j % 3;
+                table.cells[18 + i][j] = static_cast<uint8_t>(r * 9 + c);            // Box i
+            }
+        }
+        for (int u = 0; u < 27; u++) {
+            for (int j = 0; j < 9; j++) table.of[table.cells[u][j]][u / 9] = static_cast<uint8_t>(u);
+        }
+        return table;
+    }
+}
+
+/**
+ * @brief The shared peer table.
+ */
+inline constexpr PeerTable PEER_TABLE = detail::buildPeerTable();
+
+/**
+ * @brief The shared unit table.
+ */
+inline constexpr UnitTable UNIT_TABLE = detail::buildUnitTable();
+
+// Spot checks, so a slip in the builders fails the build instead of a solve
+static_assert(PEER_TABLE.box[80] == 8 && PEER_TABLE.box[30] == 4, "box numbering");
+static_assert(PEER_TABLE.peers[0][0] == 1 && PEER_TABLE.peers[0][19] == 72 && PEER_TABLE.peers[80][19] == 79,
+              "peers are listed in ascending order");
+static_assert(UNIT_TABLE.cells[20][0] == 6 && UNIT_TABLE.cells[26][8] == 80, "box units");
+static_assert(UNIT_TABLE.of[40][0] == 4 && UNIT_TABLE.of[40][1] == 13 && UNIT_TABLE.of[40][2] == 22,
+              "units of a cell");
+
+#endif //SUDOKUPROJECT_GEOMETRY_H
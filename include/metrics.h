@@ -0,0 +1,219 @@
+/**
+ * @file metrics.h
+ * @brief Per-stage latency histograms and their export as Prometheus-style text.
+ *
+ * A running batch is split into stages (parse, generate, solve, validate, write). Each stage
+ * is timed with a `StageTimer` around the code that does the work; the sample lands in a
+ * histogram owned by the calling thread, so recording takes no lock and no atomic
+ * read-modify-write, only a clock read and a few relaxed stores. `collectMetrics()` merges the
+ * histograms of every thread into a snapshot at any time, while the workers keep running.
+ *
+ * The histograms are HDR-style: 16 linear sub-buckets per power of two of nanoseconds, so
+ * every recorded latency from 16 ns to hours is kept within about 6% with a fixed 656 counters
+ * per stage and no allocation after the first sample of a thread.
+ *
+ * Batch stages time a whole chunk of boards at once; the chunk's time is spread evenly over its
+ * boards, like the "batch" engine of the benchmark.
+ *
+ * Recording is off until `setMetricsEnabled(true)` (an idle timer costs one branch). Building
+ * with `SUDOKU_METRICS=0` (CMake option `SUDOKU_METRICS=OFF`) compiles every timer out.
+ *
+ * Example:
+ * @code
+ * setMetricsEnabled(true);
+ * MetricsExporter exporter("data/metrics.prom", 5.0);  // Rewritten every 5 s and at the end
+ * {
+ *     StageTimer timer(Stage::SOLVE, n);
+ *     solveBatch(boards, n, status);
+ * }
+ * @endcode
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_METRICS_H
+#define SUDOKUPROJECT_METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+#ifndef SUDOKU_METRICS
+#define SUDOKU_METRICS 1
+#endif
+
+/**
+ * @brief The timed stages of a job.
+ */
+enum class Stage {
+    PARSE,      // Reading and parsing a puzzle
+    GENERATE,   // Making a puzzle
+    SOLVE,      // Solving a puzzle (solveBatch() chunks are spread over their boards)
+    VALIDATE,   // Checking a solution
+    WRITE,      // Writing a puzzle or solution
+};
+
+constexpr int STAGE_COUNT = 5;
+
+/**
+ * @brief Lower-case name of a stage, as used in the exported labels.
+ */
+const char* stageName(const Stage& stage);
+
+/**
+ * @brief Turns recording on or off process-wide (off by default).
+ */
+void setMetricsEnabled(const bool& enabled);
+
+/**
+ * @brief Returns true if stage timers record.
+ */
+bool metricsEnabled();
+
+/**
+ * @brief Records `items` samples of `nanoseconds / items` each for `stage` on the calling thread.
+ */
+void recordStage(const Stage& stage, const uint64_t& nanoseconds, const uint64_t& items = 1);
+
+/**
+ * @brief Times its own scope into `stage`, if metrics are enabled when it is constructed.
+ */
+class StageTimer {
+public:
+#if SUDOKU_METRICS
+    explicit StageTimer(const Stage& stage, const uint64_t& items = 1)
+        : stage(stage), items(items), start(metricsEnabled() ? now() : 0) {}
+
+    ~StageTimer() {
+        if (start != 0 && items > 0) recordStage(stage, now() - start, items);
+    }
+
+    /**
+     * @brief Changes how many boards the scope covers, e.g. once a chunk has been read.
+     */
+    void setItems(const uint64_t& n) { items = n; }
+
+private:
+    Stage stage;
+    uint64_t items;
+    uint64_t start;  // 0 = not recording
+
+    static uint64_t now() {
+        return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(
+            chrono::steady_clock::now().time_since_epoch()).count());
+    }
+#else
+    explicit StageTimer(const Stage&, const uint64_t& = 1) {}
+    void setItems(const uint64_t&) {}
+#endif
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+};
+
+/**
+ * @brief A merged, plain copy of latency histograms.
+ */
+struct HistogramSnapshot {
+    static constexpr int SUB_BUCKETS = 16;    // Linear buckets per power of two
+    static constexpr int MAX_EXPONENT = 43;   // Samples from 2^44 ns (about 4.9 hours) share the last bucket
+    static constexpr int BUCKETS = (MAX_EXPONENT - 2) * SUB_BUCKETS;
+
+    uint64_t counts[BUCKETS] = {0};
+    uint64_t count = 0;
+    uint64_t sum_ns = 0;
+    uint64_t max_ns = 0;
+
+    void add(const HistogramSnapshot& other);
+
+    /**
+     * @brief Upper bound of the bucket holding the `q` quantile (0..1), at most the maximum; 0 if empty.
+     */
+    uint64_t percentile(const double& q) const;
+
+    /**
+     * @brief Samples at or below `nanoseconds`; exact when it is one less than a power of two.
+     */
+    uint64_t countAtOrBelow(const uint64_t& nanoseconds) const;
+
+    static int bucketOf(const uint64_t& nanoseconds);
+    static uint64_t bucketLow(const int& bucket);
+    static uint64_t bucketHigh(const int& bucket);  // Inclusive
+};
+
+/**
+ * @brief Progress of one running `ProgressReporter` job.
+ */
+struct JobProgress {
+    string label;
+    int total = 0;
+    int done = 0;
+    int succeeded = 0;
+    double elapsed_seconds = 0;
+};
+
+/**
+ * @brief Everything `collectMetrics()` sees at one moment.
+ */
+struct MetricsSnapshot {
+    HistogramSnapshot stages[STAGE_COUNT];
+    vector<JobProgress> jobs;
+    double uptime_seconds = 0;  // Since the first sample or metrics start-up
+};
+
+/**
+ * @brief Merges the histograms of every thread that has recorded so far, plus the running jobs.
+ */
+MetricsSnapshot collectMetrics();
+
+/**
+ * @brief Writes `snapshot` in the Prometheus text exposition format.
+ *
+ * Per stage: a `sudoku_stage_latency_seconds` histogram with power-of-two buckets from 1 us to
+ * about 17 s, and `sudoku_stage_latency_quantile_seconds` gauges for p50, p90, p99 and p99.9.
+ * Per running job: `sudoku_job_total`, `sudoku_job_done` and `sudoku_job_succeeded`.
+ */
+void writePrometheusMetrics(const MetricsSnapshot& snapshot, ostream& out);
+
+/**
+ * @brief One line per stage that has samples: count, mean, p50, p99 and max.
+ */
+void printStageSummary(const MetricsSnapshot& snapshot, ostream& out);
+
+/**
+ * @brief Rewrites a metrics file every interval on a background thread, and once more on destruction.
+ *
+ * The file is written to `path.tmp` and renamed, so a reader never sees half a snapshot.
+ */
+class MetricsExporter {
+public:
+    MetricsExporter(const string& path, const double& interval_seconds = 5.0);
+    ~MetricsExporter();
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    /**
+     * @brief Writes the current snapshot now; false if the file could not be written.
+     */
+    bool exportNow();
+
+private:
+    string path;
+    chrono::steady_clock::duration interval;
+    mutex lock;
+    condition_variable wake;
+    bool stopping = false;
+    thread worker;
+};
+
+#endif //SUDOKUPROJECT_METRICS_H
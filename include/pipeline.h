@@ -0,0 +1,130 @@
+/**
+ * @file pipeline.h
+ * @brief Overlapped read → process → write stages with bounded, in-order hand-off.
+ *
+ * `runOrderedPipeline()` runs three stages at once, so I/O waits hide behind compute:
+ * - The calling thread reads chunks of work.
+ * - The workers of a `ThreadPool` process them, in any order and in parallel.
+ * - A writer thread consumes finished chunks strictly in the order they were read.
+ *
+ * The stages hand chunks over through a fixed set of `max_in_flight` slots that are recycled
+ * from the writer back to the reader. A reader that gets ahead waits for a free slot, and a
+ * slow writer holds slots until it is done with them, so memory stays bounded whichever stage
+ * is the bottleneck. Slot storage is reused, so chunks that keep their buffers (vectors with
+ * reserved capacity, fixed arrays) are not reallocated in steady state.
+ *
+ * Hand-offs take one short lock per chunk rather than per item, so chunks of a few dozen
+ * puzzles keep the queue far off the profile.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_PIPELINE_H
+#define SUDOKUPROJECT_PIPELINE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "thread_pool.h"
+
+/**
+ * @brief Runs `read` → `process` → `write` over chunks until `read` returns false.
+ *
+ * @tparam Chunk Default-constructible unit of work; one instance per slot, reused.
+ * @param pool Workers that run `process`.
+ * @param max_in_flight Number of slots, i.e. chunks being read, processed or written at once (>= 1).
+ * @param read `bool(Chunk&)` on the calling thread: overwrites the chunk with the next piece of
+ *        work, or returns false at the end of the input.
+ * @param process `void(Chunk&)` on a pool worker.
+ * @param write `void(Chunk&, const bool& caught_up)` on the writer thread, in read order;
+ *        `caught_up` is true if no later chunk is finished yet, i.e. a good moment to flush.
+ *
+ * Example:
+ * @code
+ * struct Lines { vector<string> items; };
+ * runOrderedPipeline<Lines>(pool, 16,
+ *     [&](Lines& chunk) { return readSome(input, chunk.items); },
+ *     [&](Lines& chunk) { transform(chunk.items); },
+ *     [&](Lines& chunk, const bool& caught_up) { emit(chunk.items, caught_up); });
+ * @endcode
+ */
+template <typename Chunk, typename Read, typename Process, typename Write>
+void runOrderedPipeline(ThreadPool& pool, const size_t& max_in_flight, Read read, Process process, Write write) {
+    struct Slot {
+        Chunk chunk;
+        bool done = false;
+    };
+
+    std::vector<Slot> slots(max_in_flight > 0 ? max_in_flight : 1);
+    std::vector<Slot*> free_slots;  // Slots no stage is using
+    std::deque<Slot*> in_order;     // Read, not yet written; oldest first
+    bool finished = false;          // The reader is done
+    std::mutex lock;
+    std::condition_variable changed;
+    for (Slot& slot : slots) free_slots.push_back(&slot);
+
+    std::thread writer([&]() {
+        while (true) {
+            Slot* slot;
+            bool caught_up;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                changed.wait(guard, [&]() { return (!in_order.empty() && in_order.front()->done) || (finished && in_order.empty()); });
+                if (in_order.empty()) return;
+                slot = in_order.front();
+                in_order.pop_front();
+                caught_up = in_order.empty() || !in_order.front()->done;
+            }
+            write(slot->chunk, caught_up);
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                free_slots.push_back(slot);
+            }
+            changed.notify_all();
+        }
+    });
+
+    while (true) {
+        Slot* slot;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            changed.wait(guard, [&]() { return !free_slots.empty(); });
+            slot = free_slots.back();
+            free_slots.pop_back();
+        }
+        if (!read(slot->chunk)) {
+            std::lock_guard<std::mutex> guard(lock);
+            free_slots.push_back(slot);
+            break;
+        }
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            slot->done = false;
+            in_order.push_back(slot);
+        }
+        pool.submit([&, slot]() {
+            process(slot->chunk);
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                slot->done = true;
+            }
+            changed.notify_all();
+        });
+    }
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        finished = true;
+    }
+    changed.notify_all();
+    writer.join();
+    // The last task may still be notifying `changed` after the writer saw its chunk done
+    pool.wait();
+}
+
+#endif //SUDOKUPROJECT_PIPELINE_H
@@ -0,0 +1,98 @@
+/**
+ * @file progress.h
+ * @brief Quiet mode and periodic progress summaries for large batch jobs.
+ *
+ * Printing a few lines per board is a measurable share of wall time once jobs reach
+ * millions of puzzles. With quiet mode on, the batch functions in sudoku_io.h stop
+ * logging per board and a `ProgressReporter` prints one summary line per interval instead.
+ *
+ * Every live reporter is also listed by `runningJobs()`, which the metrics export (metrics.h)
+ * publishes as gauges, so a large job can be watched without reading its console.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_PROGRESS_H
+#define SUDOKUPROJECT_PROGRESS_H
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "metrics.h"
+using namespace std;
+
+/**
+ * @brief Turns per-board console logging on (false, default) or off (true) process-wide.
+ */
+void setQuietMode(const bool& quiet);
+
+/**
+ * @brief Returns true if per-board logging is disabled.
+ */
+bool isQuietMode();
+
+/**
+ * @brief Thread-safe counter that prints "label: done/total (ok, rate/s)" at most once per interval.
+ *
+ * Example:
+ * @code
+ * ProgressReporter progress("solve", total);
+ * for (...) progress.tick(solved);
+ * progress.finish();
+ * @endcode
+ */
+class ProgressReporter {
+public:
+    /**
+     * @param label Prefix of every summary line.
+     * @param total Expected number of ticks.
+     * @param interval_seconds Minimum time between two summary lines.
+     */
+    ProgressReporter(const string& label, const int& total, const double& interval_seconds = 1.0);
+    ~ProgressReporter();
+    ProgressReporter(const ProgressReporter&) = delete;
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+    /**
+     * @brief Records one processed item and prints a summary if the interval has elapsed.
+     */
+    void tick(const bool& success = true);
+
+    /**
+     * @brief Prints the final summary line.
+     */
+    void finish();
+
+    int done() const { return completed.load(); }
+    int succeeded() const { return successes.load(); }
+
+    /**
+     * @brief The counts so far, as exported by the metrics.
+     */
+    JobProgress progress() const;
+
+private:
+    string label;
+    int total;
+    chrono::steady_clock::duration interval;
+    chrono::steady_clock::time_point start;
+    atomic<int> completed{0};
+    atomic<int> successes{0};
+    atomic<int64_t> next_report;  // steady_clock ticks of the next allowed summary
+    mutex print_lock;
+
+    void print(const bool& final_line);
+};
+
+/**
+ * @brief The progress of every `ProgressReporter` alive right now, oldest first.
+ */
+vector<JobProgress> runningJobs();
+
+#endif //SUDOKUPROJECT_PROGRESS_H
@@ -0,0 +1,163 @@
+/**
+ * @file puzzle_bank.h
+ * @brief Difficulty-targeted generation and a persistent bank of rated puzzles.
+ *
+ * The blank count of `generateBoard()` says little about how hard a puzzle is. Hitting a grade
+ * by generating, grading and discarding wastes most of the work, so `generateBoardInBand()`
+ * grades the puzzle with the deduction engine (see deduction.h) while it removes clues:
+ * - A removal that pushes the grade above the band is undone on the spot.
+ * - Generation stops as soon as the grade is inside the band and enough cells are blank.
+ * - As long as logic alone solves the puzzle its solution is unique, so the costly
+ *   `hasUniqueSolution()` search only runs for removals that make the puzzle EXPERT.
+ *
+ * `PuzzleBank` keeps rated puzzles in one corpus file per grade, e.g. `bank/hard.sdk`, so
+ * requests can be served from stock that was generated ahead of time.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_PUZZLE_BANK_H
+#define SUDOKUPROJECT_PUZZLE_BANK_H
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include "board.h"
+#include "deduction.h"
+#include "generator.h"
+using namespace std;
+
+const int DIFFICULTY_GRADES = 4;         // EASY, MEDIUM, HARD, EXPERT
+const int DEFAULT_BAND_MIN_BLANKS = 40;  // Blanks a puzzle needs before it may stop early
+const int DEFAULT_BAND_ATTEMPTS = 64;    // Solved grids tried before giving up on a band
+
+/**
+ * @brief What `generateBoardInBand()` should produce.
+ *
+ * - lowest, highest: Accepted grades, inclusive.
+ * - min_blanks: Clues keep being removed until at least this many cells are blank, even if the
+ *               grade is already inside the band.
+ * - max_blanks: No more than this many cells are blanked.
+ */
+struct DifficultyTarget {
+    Difficulty lowest = Difficulty::EASY;
+    Difficulty highest = Difficulty::EXPERT;
+    int min_blanks = DEFAULT_BAND_MIN_BLANKS;
+    int max_blanks = 81;
+
+    bool contains(const Difficulty& grade) const { return grade >= lowest && grade <= highest; }
+};
+
+/**
+ * @brief Parses a band such as "hard" or "medium-expert" into `target`.
+ *
+ * Only `lowest` and `highest` are changed.
+ *
+ * @return false if a grade name is unknown or the band is empty.
+ */
+bool parseDifficultyTarget(const string& text, DifficultyTarget& target);
+
+/**
+ * @brief Parses a grade name ("easy", "medium", "hard" or "expert").
+ */
+bool parseDifficulty(const string& text, Difficulty& grade);
+
+/**
+ * @brief Generates a uniquely solvable puzzle whose grade lies in `target`.
+ *
+ * Each attempt makes a new solved grid and visits its cells in random order. A cell is blanked
+ * unless that takes the grade above `target.highest` or, for EXPERT, breaks uniqueness. The
+ * attempt succeeds as soon as the grade is in the band with at least `min_blanks` blanks, or
+ * when it reaches `max_blanks`; it fails if every cell was visited without reaching the band.
+ *
+ * @param BOARD Receives the puzzle.
+ * @param target Band and blank limits.
+ * @param engine The random engine to draw from.
+ * @param grade Receives the puzzle's grade (optional).
+ * @param max_attempts Solved grids to try before giving up.
+ * @return true if a puzzle in the band was found; false leaves the last attempt in `BOARD`.
+ *
+ * Example:
+ * @code
+ * DifficultyTarget target;
+ * parseDifficultyTarget("hard-expert", target);
+ * Board board;
+ * if (generateBoardInBand(board, target, engine)) use(board);
+ * @endcode
+ */
+bool generateBoardInBand(Board& BOARD, const DifficultyTarget& target, RandomEngine& engine,
+                         Difficulty* grade = nullptr, const int& max_attempts = DEFAULT_BAND_ATTEMPTS);
+
+/**
+ * @brief Rated puzzles by grade, persisted as one corpus file per grade in a folder.
+ *
+ * Puzzles taken from the bank are removed from it, so `save()` after serving keeps the
+ * same puzzle from being handed out twice. All members are thread-safe.
+ *
+ * Example:
+ * @code
+ * PuzzleBank bank("data/bank");
+ * bank.load();
+ * bank.stock(target, 1000, 0, seed);  // Top each grade of the band up to 1000 puzzles
+ * bank.save();
+ * @endcode
+ */
+class PuzzleBank {
+public:
+    explicit PuzzleBank(const string& folder);
+
+    /**
+     * @brief Reads every grade file that exists in the folder; missing files count as empty.
+     *
+     * @return false if a file exists but is not a valid corpus.
+     */
+    bool load();
+
+    /**
+     * @brief Rewrites the grade files with the current contents (creating the folder).
+     */
+    bool save();
+
+    /**
+     * @brief Generates puzzles until every grade of `target` holds at least `per_grade` of them.
+     *
+     * Puzzle `i` of a grade is seeded with `derivePuzzleSeed(master_seed + grade, i)`.
+     *
+     * @param num_workers Worker threads: 1 = serial, <= 0 = one per hardware core.
+     * @return The number of puzzles added.
+     */
+    int stock(const DifficultyTarget& target, const int& per_grade, const int& num_workers, const uint64_t& master_seed);
+
+    /**
+     * @brief Adds a puzzle that has already been rated `grade`.
+     */
+    void add(const Board& board, const Difficulty& grade);
+
+    /**
+     * @brief Removes a puzzle in the band of `target` from the bank.
+     *
+     * Takes from the best-stocked grade of the band, so the grades drain evenly.
+     *
+     * @return false if every grade of the band is empty.
+     */
+    bool take(const DifficultyTarget& target, Board& board, Difficulty* grade = nullptr);
+
+    size_t size(const Difficulty& grade) const;
+    const string& folder() const { return root; }
+
+    /**
+     * @brief Path of the corpus file of `grade`, e.g. "data/bank/hard.sdk".
+     */
+    string gradePath(const Difficulty& grade) const;
+
+private:
+    string root;
+    vector<Board> puzzles[DIFFICULTY_GRADES];
+    mutable std::mutex lock;
+};
+
+#endif //SUDOKUPROJECT_PUZZLE_BANK_H
@@ -0,0 +1,80 @@
+/**
+ * @file puzzle_source.h
+ * @brief Streaming listing of a puzzle folder, the input-side counterpart of `DirectorySink`.
+ *
+ * `getAllSudokuInFolder()` collects, prints and sorts every path before the first puzzle is
+ * read. `DirectorySource` hands out one file at a time as the directory is scanned, so the
+ * solve pipeline can start reading and solving while a large folder is still being listed.
+ *
+ * Files come in directory order. Each one is numbered by the index in its name as written by
+ * `getFileName()` (e.g. `0042_puzzle.txt` is puzzle 42), so solution N still belongs to puzzle N
+ * without sorting the listing. Files without a leading number are numbered
+ * `UNNUMBERED_INDEX_BASE` plus their position in the listing instead, above every index a name
+ * can hold, so their solutions never overwrite those of numbered files.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_PUZZLE_SOURCE_H
+#define SUDOKUPROJECT_PUZZLE_SOURCE_H
+
+#include <filesystem>
+#include <string>
+using namespace std;
+
+const int UNNUMBERED_INDEX_BASE = 1000000000;  // First index of files without a leading number
+
+/**
+ * @brief Index a puzzle file is named with, e.g. 42 for `data/puzzles/0042_puzzle.txt`.
+ *
+ * @param path Path of the file; only its file name is looked at.
+ * @param fallback Returned if the file name does not start with a number.
+ * @return The leading number of the file name (at most nine digits), or `fallback`.
+ */
+int puzzleIndexFromName(const string& path, const int& fallback);
+
+/**
+ * @brief Lists the regular files of a folder one at a time.
+ *
+ * Example:
+ * @code
+ * DirectorySource source("data/puzzles/");
+ * string path;
+ * int index;
+ * while (source.next(path, index)) solveFile(path, index);
+ * @endcode
+ */
+class DirectorySource {
+public:
+    /**
+     * @brief Starts listing `folder`; reports on `cerr` if it cannot be opened.
+     */
+    explicit DirectorySource(const string& folder);
+
+    bool isOpen() const { return open; }
+
+    /**
+     * @brief Moves to the next regular file.
+     *
+     * @param path Receives its path.
+     * @param index Receives its puzzle index (see `puzzleIndexFromName()`).
+     * @return false once the folder is exhausted.
+     */
+    bool next(string& path, int& index);
+
+    /**
+     * @brief Number of files handed out so far.
+     */
+    int listed() const { return position; }
+
+private:
+    filesystem::directory_iterator current;
+    bool open = false;
+    int position = 0;
+};
+
+#endif //SUDOKUPROJECT_PUZZLE_SOURCE_H
@@ -0,0 +1,124 @@
+/**
+ * @file shard.h
+ * @brief Splitting a solve job across independent machines, and merging their output.
+ *
+ * A job is cut into `N` shards that need no coordinator: each node is told `--shard i/N`
+ * (0 <= i < N) and works out its slice from the input alone.
+ * - A binary corpus is split by record index into `N` contiguous ranges of near-equal size.
+ * - A puzzle folder is split by a hash of each file name, so every node keeps the same files
+ *   whatever order its directory listing comes in.
+ *
+ * Shard `i` writes to its own segment next to the final destination (`shardSegmentPath()`),
+ * plus a small text summary of its counts and search statistics. `mergeShardSegments()` then
+ * joins the `N` segments in shard order and adds up the summaries.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_SHARD_H
+#define SUDOKUPROJECT_SHARD_H
+
+#include <cstdint>
+#include <string>
+#include "solver_stats.h"
+using namespace std;
+
+/**
+ * @brief Shard `index` of `count`; the default is the whole job.
+ */
+struct ShardSpec {
+    int index = 0;
+    int count = 1;
+
+    bool isWhole() const { return count <= 1; }
+};
+
+/**
+ * @brief Parses "i/N" with 0 <= i < N.
+ *
+ * @return false (and `shard` unchanged) if `text` is not of that form.
+ */
+bool parseShardSpec(const string& text, ShardSpec& shard);
+
+/**
+ * @brief Records [begin, end) of a `total`-record corpus that belong to `shard`.
+ *
+ * The ranges of shards 0..N-1 are contiguous, disjoint and cover every record.
+ */
+void shardRange(const uint64_t& total, const ShardSpec& shard, uint64_t& begin, uint64_t& end);
+
+/**
+ * @brief true if the puzzle file at `path` belongs to `shard`.
+ *
+ * Only the file name is hashed (FNV-1a), so the answer is the same on every machine.
+ */
+bool inShard(const string& path, const ShardSpec& shard);
+
+/**
+ * @brief Where shard `i` of `N` writes instead of `destination`, e.g. "solutions.sdk.shard-3-of-8".
+ */
+string shardSegmentPath(const string& destination, const ShardSpec& shard);
+
+/**
+ * @brief Path of the summary written alongside a segment.
+ */
+string shardSummaryPath(const string& segment);
+
+/**
+ * @brief Counts of one solve run, kept per shard so they can be merged.
+ *
+ * For corpus runs `first_record` and `records` give the shard's range of source records;
+ * folder runs leave them at 0.
+ */
+struct ShardSummary {
+    uint64_t first_record = 0;
+    uint64_t records = 0;
+    uint64_t puzzles = 0;      // Puzzles read
+    uint64_t solved = 0;
+    uint64_t written = 0;
+    uint64_t quarantined = 0;  // Stopped by the node budget
+    SolverStats search;
+
+    /**
+     * @brief Adds the counts of `other`; the record range is left alone.
+     */
+    void add(const ShardSummary& other);
+};
+
+/**
+ * @brief Writes `summary` as "key value" lines.
+ */
+bool writeShardSummary(const string& path, const ShardSummary& summary);
+
+/**
+ * @brief Reads a summary written by `writeShardSummary()`; unknown keys are ignored.
+ */
+bool readShardSummary(const string& path, ShardSummary& summary);
+
+/**
+ * @brief Prints counts and search statistics the way the solve functions do.
+ */
+void printShardSummary(const ShardSummary& summary);
+
+/**
+ * @brief Joins the segments of shards 0..count-1 of `destination` into `destination`.
+ *
+ * - Corpus segments are concatenated record by record; a segment shorter than its shard's
+ *   range (its last puzzles failed) is padded with all-zero records, so record `i` of the
+ *   result still belongs to record `i` of the source corpus.
+ * - Folder segments are copied file by file into the `destination` folder.
+ *
+ * Every segment and summary must be present. The segments are left in place.
+ *
+ * @param destination Final output: a corpus file or a folder, as passed to the solve function.
+ * @param count Number of shards `N`.
+ * @param merged Receives the summed summary (optional).
+ * @return false (with a message on cerr) if a segment is missing or cannot be read or written.
+ */
+bool mergeShardSegments(const string& destination, const int& count, ShardSummary* merged = nullptr);
+
+#endif //SUDOKUPROJECT_SHARD_H
@@ -0,0 +1,113 @@
+/**
+ * @file sized_board.h
+ * @brief Boards of any order: 4x4, 9x9, 16x16 and 25x25, sized at compile time.
+ *
+ * `SizedBoard<BOX>` is a board of `BOX x BOX` boxes, i.e. `BOX^2` digits and `BOX^4` cells,
+ * stored row-major like `Board`. Everything that depends on the size is a compile-time
+ * constant of `BoardGeometry<BOX>`, so each order gets its own fully specialised code:
+ * - `SIZE`, `CELLS` and the row/column/box of a cell fold to constants and shifts.
+ * - `Mask`, the type of a digit set, is `uint16_t` up to 16x16 and `uint32_t` for 25x25.
+ *
+ * `SizedBoard<3>` has the layout of `Board`, and the 9x9 instantiations of the sized
+ * solver forward to the tuned 9x9 engines, so the classic size pays nothing for the rest.
+ *
+ * Text uses one character per cell: `1`-`9`, then `A`-`P` for 10-25, and `0`, `.` or `-`
+ * for blanks.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_SIZED_BOARD_H
+#define SUDOKUPROJECT_SIZED_BOARD_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include "board.h"
+
+/**
+ * @brief Size constants and cell geometry of a board with `BOX x BOX` boxes.
+ */
+template <int BOX>
+struct BoardGeometry {
+    static_assert(BOX >= 2 && BOX <= 5, "Supported orders are 4x4, 9x9, 16x16 and 25x25");
+
+    static constexpr int SIZE = BOX * BOX;     // Digits, and cells in every unit
+    static constexpr int CELLS = SIZE * SIZE;
+    typedef typename std::conditional<(SIZE <= 16), uint16_t, uint32_t>::type Mask;
+    static constexpr Mask ALL = static_cast<Mask>((uint64_t(1) << SIZE) - 1);  // Bit k - 1 = digit k
+
+    static constexpr int row(const int& cell) { return cell / SIZE; }
+    static constexpr int col(const int& cell) { return cell % SIZE; }
+    static constexpr int box(const int& cell) { return (row(cell) / BOX) * BOX + col(cell) / BOX; }
+};
+
+/**
+ * @brief A board of `BOX x BOX` boxes; 0 = empty, digits 1..BOX^2.
+ *
+ * Example:
+ * @code
+ * Board16 board{};
+ * board(0, 0) = 16;
+ * @endcode
+ */
+template <int BOX>
+struct SizedBoard {
+    static constexpr int SIZE = BoardGeometry<BOX>::SIZE;
+    static constexpr int CELLS = BoardGeometry<BOX>::CELLS;
+
+    uint8_t cells[CELLS];
+
+    uint8_t& operator()(const int& r, const int& c) { return cells[r * SIZE + c]; }
+    const uint8_t& operator()(const int& r, const int& c) const { return cells[r * SIZE + c]; }
+};
+
+typedef SizedBoard<2> Board4;
+typedef SizedBoard<4> Board16;
+typedef SizedBoard<5> Board25;
+
+static_assert(sizeof(SizedBoard<3>) == sizeof(Board), "SizedBoard<3> must share Board's layout");
+
+/**
+ * @brief Copies a `Board` into a `SizedBoard<3>`.
+ */
+inline SizedBoard<3> toSizedBoard(const Board& board) {
+    SizedBoard<3> sized;
+    memcpy(sized.cells, board.cells, sizeof(sized.cells));
+    return sized;
+}
+
+/**
+ * @brief Copies a `SizedBoard<3>` into a `Board`.
+ */
+inline Board toBoard(const SizedBoard<3>& sized) {
+    Board board;
+    memcpy(board.cells, sized.cells, sizeof(board.cells));
+    return board;
+}
+
+/**
+ * @brief Cell symbols by digit: `SIZED_SYMBOLS[k - 1]` stands for digit k.
+ */
+const char SIZED_SYMBOLS[] = "123456789ABCDEFGHIJKLMNOP";
+
+/**
+ * @brief Parses one board of `BOX^4` symbols; surrounding whitespace is ignored.
+ *
+ * @return true if `text` is exactly one board whose digits are all at most `BOX^2`.
+ */
+template <int BOX>
+bool parseSizedLine(const std::string& text, SizedBoard<BOX>& board);
+
+/**
+ * @brief Formats a board as `BOX^4` symbols with `.` for blanks into `content`.
+ */
+template <int BOX>
+void sizedBoardToLine(const SizedBoard<BOX>& board, std::string& content);
+
+#endif //SUDOKUPROJECT_SIZED_BOARD_H
@@ -0,0 +1,128 @@
+/**
+ * @file solution_cache.h
+ * @brief Thread-safe LRU cache from canonical puzzle to solution.
+ *
+ * Puzzles are stored under their `canonicalForm()`, so a re-submitted puzzle and any rotated,
+ * reflected, band/stack-shuffled or relabelled variant of it share one entry. The entry holds
+ * the solution of the canonical board; a hit maps it back through the inverse of the looked-up
+ * puzzle's transform, which always yields a solution of that puzzle.
+ *
+ * The cache is split into shards, each with its own lock, LRU list and hash index, so workers
+ * solving different puzzles rarely wait on each other. Keys and solutions are packed to 41
+ * bytes with `packBoard()`.
+ *
+ * A lookup canonicalizes the puzzle first, which costs more than solving a typical generated
+ * one, so the cache only pays off when puzzles repeat (e.g. a service fed the same puzzles
+ * again); `solve` keeps it off unless `--cache N` is given.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_SOLUTION_CACHE_H
+#define SUDOKUPROJECT_SOLUTION_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "board.h"
+#include "canonical.h"
+#include "corpus.h"
+
+/**
+ * @brief Default number of solutions kept by `serve` and by a `SolutionCache` built without a capacity.
+ */
+const size_t DEFAULT_SOLUTION_CACHE_CAPACITY = 1 << 16;
+
+/**
+ * @brief Sharded LRU cache of solutions keyed by canonical board.
+ *
+ * Example:
+ * @code
+ * SolutionCache cache(10000);
+ * Board solution;
+ * if (!cache.lookup(puzzle, solution)) {
+ *     solution = puzzle;
+ *     if (solve(solution, SolverType::DLX)) cache.insert(puzzle, solution);
+ * }
+ * @endcode
+ */
+class SolutionCache {
+public:
+    /**
+     * @param capacity Maximum number of solutions kept (at least one per shard).
+     * @param num_shards Number of independently locked shards.
+     */
+    explicit SolutionCache(const size_t& capacity = DEFAULT_SOLUTION_CACHE_CAPACITY, const int& num_shards = 16);
+    SolutionCache(const SolutionCache&) = delete;
+    SolutionCache& operator=(const SolutionCache&) = delete;
+
+    /**
+     * @brief Looks up an already canonicalized puzzle.
+     *
+     * @param form `canonicalForm()` of the puzzle.
+     * @param solution Receives the solution of the original puzzle on a hit.
+     * @return true on a hit.
+     */
+    bool find(const CanonicalBoard& form, Board& solution);
+
+    /**
+     * @brief Stores the solution of the puzzle whose canonical form is `form`.
+     *
+     * @param form `canonicalForm()` of the puzzle.
+     * @param solution Solution of the original (not canonical) puzzle.
+     */
+    void store(const CanonicalBoard& form, const Board& solution);
+
+    /**
+     * @brief `find()` that canonicalizes `puzzle` first.
+     */
+    bool lookup(const Board& puzzle, Board& solution);
+
+    /**
+     * @brief `store()` that canonicalizes `puzzle` first.
+     */
+    void insert(const Board& puzzle, const Board& solution);
+
+    size_t size() const;
+    size_t capacity() const { return shard_capacity * shards.size(); }
+    uint64_t hits() const { return hit_count.load(); }
+    uint64_t misses() const { return miss_count.load(); }
+
+private:
+    struct Key {
+        uint8_t bytes[CORPUS_RECORD_SIZE];
+        bool operator==(const Key& other) const;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        Key key;
+        uint8_t solution[CORPUS_RECORD_SIZE];  // Solution of the canonical board
+    };
+
+    struct Shard {
+        mutable std::mutex lock;
+        std::list<Entry> entries;  // Most recently used first
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    size_t shard_capacity;
+    std::atomic<uint64_t> hit_count{0};
+    std::atomic<uint64_t> miss_count{0};
+
+    Shard& shardOf(const size_t& hash);
+};
+
+#endif //SUDOKUPROJECT_SOLUTION_CACHE_H
@@ -0,0 +1,139 @@
+/**
+ * @file solve_budget.h
+ * @brief Deadlines, node budgets and cancellation for the solver engines.
+ *
+ * A `SolveBudget` bounds one solve by any combination of:
+ * - A node budget: the number of tentative placements the search may make.
+ * - A deadline on `steady_clock`.
+ * - A `CancellationToken` that another thread can trigger at any time.
+ *
+ * The budget is enforced by `BudgetRecorder`, which every engine's search asks before each
+ * node through the recorder's `stop()` member (see solver_stats.h). Unbudgeted solves use
+ * recorders whose `stop()` is a constant `false`, so they pay nothing for it. The deadline
+ * and the token are only looked at every `BUDGET_CHECK_INTERVAL` nodes to keep clock reads
+ * and atomic loads off the hot path.
+ *
+ * A bounded `solve()` returns a `SolveStatus` instead of a bool; the board is left as it was
+ * given unless the status is `SOLVED`.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_SOLVE_BUDGET_H
+#define SUDOKUPROJECT_SOLVE_BUDGET_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "solver_stats.h"
+
+/**
+ * @brief Outcome of a bounded solve.
+ */
+enum class SolveStatus { SOLVED, UNSOLVABLE, BUDGET_EXCEEDED };
+
+/**
+ * @brief Lower-case name of a status ("solved", "unsolvable", "budget-exceeded").
+ */
+const char* solveStatusName(const SolveStatus& status);
+
+/**
+ * @brief Flag shared between a solver and the thread that may cancel it.
+ */
+class CancellationToken {
+public:
+    void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+    void reset() { cancelled.store(false, std::memory_order_relaxed); }
+    bool isCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> cancelled{false};
+};
+
+/**
+ * @brief Limits of one solve; the default budget is unlimited.
+ *
+ * Example:
+ * @code
+ * CancellationToken token;
+ * SolveBudget budget = SolveBudget::within(std::chrono::milliseconds(5));
+ * budget.max_nodes = 100000;
+ * budget.token = &token;
+ * SolveStatus status = solve(board, SolverType::BITMASK, budget);
+ * @endcode
+ */
+struct SolveBudget {
+    uint64_t max_nodes = 0;  // 0 = no node limit
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+    const CancellationToken* token = nullptr;  // Not owned; may be nullptr
+
+    /**
+     * @brief A budget of at most `nodes` search nodes.
+     */
+    static SolveBudget nodes(const uint64_t& nodes) {
+        SolveBudget budget;
+        budget.max_nodes = nodes;
+        return budget;
+    }
+
+    /**
+     * @brief A budget that expires `timeout` from now.
+     */
+    template <typename Rep, typename Period>
+    static SolveBudget within(const std::chrono::duration<Rep, Period>& timeout) {
+        SolveBudget budget;
+        budget.deadline = std::chrono::steady_clock::now() +
+                          std::chrono::duration_cast<std::chrono::steady_clock::duration>(timeout);
+        return budget;
+    }
+
+    bool isUnlimited() const {
+        return max_nodes == 0 && token == nullptr && deadline == std::chrono::steady_clock::time_point::max();
+    }
+};
+
+/**
+ * @brief Nodes between two looks at the deadline and the cancellation token.
+ */
+const uint64_t BUDGET_CHECK_INTERVAL = 256;
+
+/**
+ * @brief Recorder that enforces a `SolveBudget` and forwards every event to `Inner`.
+ */
+template <typename Inner>
+struct BudgetRecorder {
+    Inner& inner;
+    const SolveBudget& budget;
+    uint64_t nodes = 0;
+    bool exceeded = false;
+
+    BudgetRecorder(Inner& target, const SolveBudget& limits) : inner(target), budget(limits) {}
+
+    /**
+     * @brief true once the budget is used up; the search then stops before its next node.
+     */
+    bool stop() {
+        if (exceeded) return true;
+        if (budget.max_nodes != 0 && nodes >= budget.max_nodes) {
+            exceeded = true;
+        } else if (nodes % BUDGET_CHECK_INTERVAL == 0) {
+            exceeded = (budget.token != nullptr && budget.token->isCancelled()) ||
+                       std::chrono::steady_clock::now() >= budget.deadline;
+        }
+        return exceeded;
+    }
+
+    void node(const int& depth) { nodes++; inner.node(depth); }
+    void backtrack() { inner.backtrack(); }
+    void propagated(const uint64_t& steps) { inner.propagated(steps); }
+    uint64_t clock() { return inner.clock(); }
+    void addSelection(const uint64_t& since) { inner.addSelection(since); }
+    void addPlacement(const uint64_t& since) { inner.addPlacement(since); }
+    void addPropagation(const uint64_t& since) { inner.addPropagation(since); }
+};
+
+#endif //SUDOKUPROJECT_SOLVE_BUDGET_H
@@ -0,0 +1,147 @@
+/**
+ * @file solver_service.h
+ * @brief Long-running solver service that streams puzzles in and solutions out.
+ *
+ * The service keeps one warm process (worker pool, solution cache, per-thread solver state)
+ * for a whole stream of puzzles instead of paying start-up, folder setup and file I/O per
+ * puzzle. Puzzles arrive on an input stream one per line, in the line layout of
+ * `parseSudokuLine()`; blank lines are skipped and every other line produces exactly one output
+ * line, in input order:
+ * - The 81-digit solution, if it was solved.
+ * - `unsolvable` or `budget-exceeded` (see `solveStatusName()`).
+ * - `error: <reason>` if the line is not a puzzle.
+ *
+ * Reading, solving and writing overlap: the calling thread parses puzzles into chunks and hands
+ * each chunk to the pool as soon as it is full or no more input is buffered, while a writer
+ * thread drains finished chunks in order. At most `ServiceConfig::max_in_flight` chunks are
+ * outstanding, so a fast producer cannot queue unbounded work. Output is flushed whenever the
+ * writer catches up with the solvers, so an interactive client gets each answer right away.
+ *
+ * `runSocketService()` serves the same protocol on a Unix-domain or TCP socket (POSIX only), and
+ * a `MetricsEndpoint` publishes the stage latencies of metrics.h over HTTP while it runs.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_SOLVER_SERVICE_H
+#define SUDOKUPROJECT_SOLVER_SERVICE_H
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "sudoku.h"
+#include "sudoku_io.h"
+#include "solution_cache.h"
+#include "thread_pool.h"
+using namespace std;
+
+/**
+ * @brief Settings of a solver service.
+ */
+struct ServiceConfig {
+    int num_workers = 0;                          // <= 0 = all cores
+    SolverType fallback = SolverType::BITMASK;    // Engine for boards propagation does not finish
+    uint64_t node_budget = DEFAULT_PUZZLE_NODE_BUDGET;  // Per puzzle; 0 = unlimited
+    size_t cache_capacity = DEFAULT_SOLUTION_CACHE_CAPACITY;  // 0 = no cache
+    int chunk_size = 64;                          // Puzzles per pool task (rounded up to BATCH_LANES)
+    int max_in_flight = 0;                        // Outstanding chunks; <= 0 = 4 per worker
+};
+
+/**
+ * @brief Counts of one served stream.
+ */
+struct ServiceSummary {
+    uint64_t puzzles = 0;
+    uint64_t solved = 0;
+    uint64_t unsolvable = 0;
+    uint64_t budget_exceeded = 0;
+    uint64_t malformed = 0;
+
+    void add(const ServiceSummary& other);
+};
+
+/**
+ * @brief A warm solver: worker pool and solution cache shared by every stream it serves.
+ *
+ * Example:
+ * @code
+ * SolverService service(ServiceConfig{});
+ * ServiceSummary summary = service.serve(cin, cout);  // Until end of input
+ * @endcode
+ */
+class SolverService {
+public:
+    explicit SolverService(const ServiceConfig& config);
+    SolverService(const SolverService&) = delete;
+    SolverService& operator=(const SolverService&) = delete;
+
+    /**
+     * @brief Answers every puzzle of `input` on `output` until `input` ends.
+     *
+     * Streams are served one at a time; `serve()` must not be called concurrently.
+     */
+    ServiceSummary serve(istream& input, ostream& output);
+
+    const ServiceConfig& config() const { return settings; }
+    const SolutionCache* cache() const { return solutions.get(); }
+
+private:
+    ServiceConfig settings;
+    ThreadPool pool;
+    unique_ptr<SolutionCache> solutions;
+};
+
+/**
+ * @brief Prints a one-line summary of a served stream to `out`.
+ */
+void printServiceSummary(const ServiceSummary& summary, ostream& out);
+
+/**
+ * @brief Serves clients on a socket until the process is stopped.
+ *
+ * Clients are served one after another, each until it closes its end of the connection; the
+ * warm service is shared between them.
+ *
+ * @param address `unix:PATH`, `tcp:PORT` (loopback only) or `tcp:HOST:PORT`, HOST being an IPv4 address.
+ * @param config Settings of the service.
+ * @return false if the socket could not be opened or stopped accepting connections.
+ */
+bool runSocketService(const string& address, const ServiceConfig& config);
+
+/**
+ * @brief Answers every connection on a socket with the current metrics as a plain-text HTTP response.
+ *
+ * A Prometheus scraper or `curl http://127.0.0.1:PORT/metrics` reads it while the service runs;
+ * the request path is ignored. Connections are answered one at a time on a background thread,
+ * which the destructor stops (POSIX only).
+ *
+ * Example:
+ * @code
+ * MetricsEndpoint endpoint;
+ * if (!endpoint.open("tcp:9100")) return 1;
+ * @endcode
+ */
+class MetricsEndpoint {
+public:
+    MetricsEndpoint() = default;
+    ~MetricsEndpoint();
+    MetricsEndpoint(const MetricsEndpoint&) = delete;
+    MetricsEndpoint& operator=(const MetricsEndpoint&) = delete;
+
+    /**
+     * @param address `unix:PATH`, `tcp:PORT` (loopback only) or `tcp:HOST:PORT`, as for `runSocketService()`.
+     * @return false if the socket could not be opened.
+     */
+    bool open(const string& address);
+
+private:
+    int listener = -1;
+    thread worker;
+};
+
+#endif //SUDOKUPROJECT_SOLVER_SERVICE_H
@@ -0,0 +1,112 @@
+/**
+ * @file solver_stats.h
+ * @brief Optional search statistics for the solver engines.
+ *
+ * Every engine's search is a template over a *recorder* that it notifies about each node,
+ * backtrack and propagation step, and around cell selection and placement:
+ * - `NullRecorder` has empty inline members, so the default `solve()` paths compile to
+ *   exactly the code they had before; there is no runtime "stats enabled?" check.
+ * - `StatsRecorder<false>` (`CountingRecorder`) fills the counters of a `SolverStats`.
+ * - `StatsRecorder<true>` (`TimingRecorder`) also measures the time spent per phase; the
+ *   clock reads make it noticeably slower, so use it for diagnosis, not for benchmarks.
+ *
+ * Counter meaning is the same for all engines: a *node* is one tentative placement made by
+ * the search, a *backtrack* is one placement that had to be undone, and *depth* is the number
+ * of search placements on the board at the same time. *Propagation steps* are deductions
+ * made without guessing: cells and eliminations of the logical pre-pass (efficient),
+ * column covers (DLX) and propagation rounds (batch).
+ *
+ * Before each node the search also asks the recorder's `stop()` whether to give up; only
+ * `BudgetRecorder` (solve_budget.h) ever says yes.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_SOLVER_STATS_H
+#define SUDOKUPROJECT_SOLVER_STATS_H
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Search statistics of one or more solves.
+ */
+struct SolverStats {
+    uint64_t nodes = 0;
+    uint64_t backtracks = 0;
+    uint64_t propagation_steps = 0;
+    int max_depth = 0;
+    uint64_t selection_ns = 0;    // Choosing the next cell (TimingRecorder only)
+    uint64_t placement_ns = 0;    // Placing and removing digits (TimingRecorder only)
+    uint64_t propagation_ns = 0;  // Logical propagation (TimingRecorder only)
+
+    /**
+     * @brief Adds the counters and timings of `other`; keeps the larger `max_depth`.
+     */
+    void add(const SolverStats& other) {
+        nodes += other.nodes;
+        backtracks += other.backtracks;
+        propagation_steps += other.propagation_steps;
+        if (other.max_depth > max_depth) max_depth = other.max_depth;
+        selection_ns += other.selection_ns;
+        placement_ns += other.placement_ns;
+        propagation_ns += other.propagation_ns;
+    }
+};
+
+/**
+ * @brief Recorder that records nothing; every call compiles away.
+ */
+struct NullRecorder {
+    bool stop() { return false; }
+    void node(const int&) {}
+    void backtrack() {}
+    void propagated(const uint64_t&) {}
+    uint64_t clock() { return 0; }
+    void addSelection(const uint64_t&) {}
+    void addPlacement(const uint64_t&) {}
+    void addPropagation(const uint64_t&) {}
+};
+
+/**
+ * @brief Recorder that writes into a `SolverStats`; `TIMED` also measures per-phase time.
+ */
+template <bool TIMED>
+struct StatsRecorder {
+    SolverStats& stats;
+
+    explicit StatsRecorder(SolverStats& target) : stats(target) {}
+
+    bool stop() { return false; }
+
+    /**
+     * @brief A tentative placement at search depth `depth` (1 = first guess).
+     */
+    void node(const int& depth) {
+        stats.nodes++;
+        if (depth > stats.max_depth) stats.max_depth = depth;
+    }
+    void backtrack() { stats.backtracks++; }
+    void propagated(const uint64_t& steps) { stats.propagation_steps += steps; }
+
+    /**
+     * @brief Current time in nanoseconds, or 0 when not timing.
+     */
+    uint64_t clock() {
+        if (!TIMED) return 0;
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+    void addSelection(const uint64_t& since) { if (TIMED) stats.selection_ns += clock() - since; }
+    void addPlacement(const uint64_t& since) { if (TIMED) stats.placement_ns += clock() - since; }
+    void addPropagation(const uint64_t& since) { if (TIMED) stats.propagation_ns += clock() - since; }
+};
+
+typedef StatsRecorder<false> CountingRecorder;
+typedef StatsRecorder<true> TimingRecorder;
+
+#endif //SUDOKUPROJECT_SOLVER_STATS_H
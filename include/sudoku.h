@@ -8,8 +8,9 @@
  * - A cell validation function to ensure valid number placement.
  * - A board generation stub for creating Sudoku puzzles.
  *
- * All functions operate on dynamically allocated 9x9 Sudoku boards
- * represented as `int**`, where empty cells are denoted by 0.
+ * All functions operate on 9x9 Sudoku boards where empty cells are denoted by 0,
+ * either as a flat `Board` value (see board.h) or as a dynamically allocated
+ * `int**`. The `int**` overloads are thin adapters over the `Board` implementations.
  *
  * @author
  * Keshav Bhandari
@@ -22,6 +23,12 @@
 #define SUDOKUPROJECT_SUDOKU_H
 
 #include <iostream>
+#include <cstdint>
+#include <tuple>
+#include <string>
+#include "board.h"
+#include "solver_stats.h"
+#include "solve_budget.h"
 
 /**
  * @brief Checks if a number is valid to be placed in a given cell of a Sudoku board.
@@ -55,6 +62,11 @@
  */
 bool isValid(int** BOARD, const int& r, const int& c, const int& k);
 
+/**
+ * @brief `Board` overload of `isValid()`.
+ */
+bool isValid(const Board& BOARD, const int& r, const int& c, const int& k);
+
 /**
  * @brief Solves a 9x9 Sudoku board using a backtracking algorithm.
  *
@@ -77,9 +89,17 @@ bool isValid(int** BOARD, const int& r, const int& c, const int& k);
  * to check if placing numbers 1 to 9 at a given position will lead to a valid solution. If a solution is found, it
  * returns `true`. If a placement leads to no valid solution, it backtracks and tries the next possible number.
  *
+ * @note The search is implemented iteratively over a fixed stack of at most 81 entries (one per empty cell),
+ * so it visits the same placements in the same order without one call frame per cell.
+ *
  **/
 bool solveBoard(int** BOARD, const int& r=0, const int& c=0);
 
+/**
+ * @brief `Board` overload of `solveBoard()`.
+ */
+bool solveBoard(Board& BOARD, const int& r=0, const int& c=0);
+
 
 // ========================= Efficient Solutions ==========================
 
@@ -113,6 +133,11 @@ bool solveBoard(int** BOARD, const int& r=0, const int& c=0);
  */
 std::tuple<int, int, int> findNextCell(int** BOARD);
 
+/**
+ * @brief `Board` overload of `findNextCell()`.
+ */
+std::tuple<int, int, int> findNextCell(const Board& BOARD);
+
 
 /**
  * @brief Solves Sudoku using backtracking with MRV heuristic for optimization.
@@ -123,11 +148,93 @@ std::tuple<int, int, int> findNextCell(int** BOARD);
  * @param BOARD 9x9 Sudoku board (modified in-place)
  * @return true if solved, false if unsolvable
  *
- * @note Relies on findNextCell() for MRV selection and isValid() for constraints.
- *       Backtracks automatically when dead-ends are encountered.
+ * @note A logical pre-pass (`deduce()`, see deduction.h) fills every cell that naked singles, hidden
+ *       singles and locked candidates determine; only the remaining cells are searched.
+ * @note MRV selection is maintained incrementally by `CandidateTracker` (see cell_selection.h), so
+ *       picking the next cell does not rescan the board. `solveBoardWithSelection<Policy>()` runs the
+ *       same search with a different selection policy. Backtracks automatically when dead-ends are encountered.
  */
 bool solveBoardEfficient(int** BOARD);
 
+/**
+ * @brief `Board` overload of `solveBoardEfficient()`.
+ */
+bool solveBoardEfficient(Board& BOARD);
+
+
+// ========================= Bitmask Solutions ==========================
+
+
+/**
+ * @brief Available solver engines that can be selected through `solve()`.
+ *
+ * - BASIC:     Plain cell-by-cell backtracking (`solveBoard`).
+ * - EFFICIENT: Backtracking with the MRV heuristic (`solveBoardEfficient`).
+ * - BITMASK:   Backtracking on incrementally maintained candidate masks (`solveBoardBitmask`).
+ * - DLX:       Dancing Links exact-cover search (`solveBoardDlx`).
+ */
+enum class SolverType { BASIC, EFFICIENT, BITMASK, DLX };
+
+/**
+ * @brief Every solver engine, in the order used by reports and benchmarks.
+ */
+const SolverType ALL_SOLVER_TYPES[] = { SolverType::BASIC, SolverType::EFFICIENT, SolverType::BITMASK, SolverType::DLX };
+
+/**
+ * @brief Lower-case name of a solver engine ("basic", "efficient", "bitmask", "dlx").
+ */
+const char* solverName(const SolverType& solver);
+
+/**
+ * @brief Looks up a solver engine by the name returned from `solverName()`.
+ *
+ * @param name The engine name.
+ * @param solver Receives the engine if the name is known.
+ * @return true if `name` is a known engine.
+ */
+bool parseSolverType(const std::string& name, SolverType& solver);
+
+
+/**
+ * @brief Solves Sudoku using per-row, per-column and per-box 9-bit candidate masks.
+ *
+ * Bit (k - 1) of a unit mask is set when digit k is already used in that row, column or 3x3 box.
+ * The masks are updated incrementally on every place/unplace, so the candidates of a cell are
+ * `~(rows[r] | cols[c] | boxes[b]) & 0x1FF`: counting them is a popcount and enumerating them is a
+ * bit-scan, instead of the ~27 board loads per digit that `isValid()` needs. The next cell is picked
+ * with the same MRV rule as `findNextCell()`.
+ *
+ * @param BOARD 9x9 Sudoku board (modified in-place)
+ * @return true if solved, false if unsolvable (including boards whose givens already conflict)
+ */
+bool solveBoardBitmask(int** BOARD);
+
+/**
+ * @brief `Board` overload of `solveBoardBitmask()`.
+ */
+bool solveBoardBitmask(Board& BOARD);
+
+
+// ========================= Dancing Links Solutions ==========================
+
+
+/**
+ * @brief Solves Sudoku as an exact-cover problem with Dancing Links (see dlx.h).
+ *
+ * Each thread keeps one preallocated `DlxSolver` whose node arena is reused for every puzzle,
+ * so a solve performs no allocation. Latency stays low and predictable on 17-clue and
+ * near-empty boards where the backtracking engines slow down.
+ *
+ * @param BOARD 9x9 Sudoku board (modified in-place)
+ * @return true if solved, false if unsolvable (including boards whose givens already conflict)
+ */
+bool solveBoardDlx(int** BOARD);
+
+/**
+ * @brief `Board` overload of `solveBoardDlx()`.
+ */
+bool solveBoardDlx(Board& BOARD);
+
 
 /**
  * @brief Solves a Sudoku board using either basic or optimized backtracking.
@@ -138,4 +245,107 @@ bool solveBoardEfficient(int** BOARD);
  */
 bool solve(int** board, const bool& efficient = false);
 
+/**
+ * @brief Solves a Sudoku board with an explicitly selected solver engine.
+ *
+ * @param board 9x9 Sudoku board (0 = empty)
+ * @param solver The engine to run (see `SolverType`)
+ * @return true if solved, false if unsolvable
+ */
+bool solve(int** board, const SolverType& solver);
+
+/**
+ * @brief `Board` overload of `solve()` selecting basic or optimized backtracking.
+ */
+bool solve(Board& board, const bool& efficient = false);
+
+/**
+ * @brief `Board` overload of `solve()` with an explicitly selected solver engine.
+ */
+bool solve(Board& board, const SolverType& solver);
+
+/**
+ * @brief `solve()` that also records search statistics (see solver_stats.h).
+ *
+ * Counters are added to `stats`, so one struct can accumulate many solves.
+ *
+ * @param board 9x9 Sudoku board (0 = empty)
+ * @param solver The engine to run
+ * @param stats Receives nodes, backtracks, maximum depth and propagation steps
+ * @param timed Also measure time in cell selection, placement and propagation (slower)
+ * @return true if solved, false if unsolvable
+ */
+bool solve(Board& board, const SolverType& solver, SolverStats& stats, const bool& timed = false);
+
+/**
+ * @brief Solves within a deadline and/or node budget, stopping early if the budget's token is cancelled.
+ *
+ * Every engine checks the budget before each search node. `SolverType::EFFICIENT` runs
+ * `deduce()` first, so it never cuts off a puzzle that logic alone finishes; BASIC, BITMASK and
+ * DLX search from the first cell and can be stopped on any puzzle.
+ *
+ * @param board 9x9 Sudoku board (0 = empty); left unchanged unless the result is `SOLVED`
+ * @param solver The engine to run
+ * @param budget Limits of this solve (see solve_budget.h)
+ * @return SOLVED, UNSOLVABLE, or BUDGET_EXCEEDED when the search was stopped before it finished
+ *
+ * Example:
+ * @code
+ * SolveStatus status = solve(board, SolverType::DLX, SolveBudget::within(std::chrono::milliseconds(2)));
+ * if (status == SolveStatus::BUDGET_EXCEEDED) quarantine(board);
+ * @endcode
+ */
+SolveStatus solve(Board& board, const SolverType& solver, const SolveBudget& budget);
+
+/**
+ * @brief Budgeted `solve()` that also adds search statistics to `stats`.
+ */
+SolveStatus solve(Board& board, const SolverType& solver, const SolveBudget& budget, SolverStats& stats);
+
+/**
+ * @brief Budgeted `solveWithRecorder()`; `inner` receives the events (instantiated for
+ *        `NullRecorder` and `CountingRecorder`).
+ */
+template <typename Inner>
+SolveStatus solveWithinBudget(Board& board, const SolverType& solver, const SolveBudget& budget, Inner& inner);
+
+/**
+ * @brief Runs one engine with a compile-time recorder; the extension point for new engines.
+ *
+ * Instantiated for `NullRecorder`, `CountingRecorder`, `TimingRecorder` and the
+ * `BudgetRecorder` of the first two.
+ */
+template <typename Recorder>
+bool solveWithRecorder(Board& board, const SolverType& solver, Recorder& recorder);
+
+
+/**
+ * @brief Counts the solutions of a board, stopping as soon as `limit` solutions have been found.
+ *
+ * Runs the incremental MRV bitmask search without writing to the board, so checking uniqueness
+ * (`limit = 2`) explores only until a second solution appears instead of the whole search tree.
+ *
+ * @param board 9x9 Sudoku board (0 = empty); not modified
+ * @param limit Maximum number of solutions to look for
+ * @return int Number of solutions found, at most `limit` (0 if the givens already conflict)
+ *
+ * Example:
+ * @code
+ * if (countSolutions(board, 2) == 1) {
+ *     // The puzzle has exactly one solution
+ * }
+ * @endcode
+ */
+int countSolutions(const Board& board, const int& limit = 2);
+
+/**
+ * @brief `int**` overload of `countSolutions()`.
+ */
+int countSolutions(int** board, const int& limit = 2);
+
+/**
+ * @brief Returns true if the board has exactly one solution.
+ */
+bool hasUniqueSolution(const Board& board);
+
 #endif //SUDOKUPROJECT_SUDOKU_H
\ No newline at end of file
@@ -10,8 +10,8 @@
  * - Generate and solve multiple Sudoku puzzles.
  * - Handle file system operations to read puzzle sets from directories.
  *
- * The functions work with a dynamically allocated 9x9 Sudoku board
- * represented as `int**`, where empty cells are denoted by 0.
+ * The functions work with 9x9 Sudoku boards where empty cells are denoted by 0,
+ * either as a flat `Board` value or as a dynamically allocated `int**`.
  *
  * @author
  * Keshav Bhandari
@@ -25,8 +25,57 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
+#include "board.h"
+#include "shard.h"
+#include "sudoku.h"
 using namespace std;
 
+/**
+ * @brief Default per-puzzle node budget of the solve pipelines.
+ *
+ * The fallback engine needs a few thousand nodes on typical hard puzzles, so only boards that
+ * are pathological for it hit this limit.
+ */
+const uint64_t DEFAULT_PUZZLE_NODE_BUDGET = 2000000;
+
+/**
+ * @brief How the solve pipelines check the solutions they are about to write.
+ *
+ * - FULL:    Every solution is checked with `validateBatch()` (the default).
+ * - SAMPLED: Only every `VALIDATION_SAMPLE_INTERVAL`-th puzzle is checked, which still catches
+ *            an engine that has gone wrong without paying for every board.
+ * - NONE:    Solutions are trusted as the engine returns them.
+ *
+ * A solution that fails its check is not written and is reported on `cerr`.
+ */
+enum class ValidationMode { FULL, SAMPLED, NONE };
+
+/**
+ * @brief One puzzle in this many is checked under `ValidationMode::SAMPLED`.
+ */
+const int VALIDATION_SAMPLE_INTERVAL = 64;
+
+/**
+ * @brief Looks up a validation mode by name ("full", "sampled" or "none").
+ */
+bool parseValidationMode(const string& name, ValidationMode& mode);
+
+/**
+ * @brief Outcome of a solve job; `solve` turns it into its exit status.
+ *
+ * - COMPLETE:   Every puzzle was solved, passed validation and was written.
+ * - INCOMPLETE: The job ran, but some puzzles were malformed, unsolvable, quarantined, failed
+ *               validation or could not be written.
+ * - FAILED:     The input or output could not be opened or finalized.
+ */
+enum class SolveJobStatus { COMPLETE, INCOMPLETE, FAILED };
+
+class BoardSink;
+class PuzzleBank;
+struct DifficultyTarget;
+enum class TextLayout;
+
 /**
  * @brief Prints the Sudoku board to the console with highlighting.
  *
@@ -43,6 +92,11 @@ using namespace std;
  */
 void printBoard(int** BOARD, const int& r=0, const int& c=0, int k=0,const bool& color = true );
 
+/**
+ * @brief `Board` overload of `printBoard()`.
+ */
+void printBoard(const Board& BOARD, const int& r=0, const int& c=0, int k=0,const bool& color = true );
+
 /**
  * @brief Converts the Sudoku board into a string representation.
  *
@@ -54,10 +108,16 @@ void printBoard(int** BOARD, const int& r=0, const int& c=0, int k=0,const bool&
  */
 void boardToString(int** BOARD, string& content);
 
+/**
+ * @brief `Board` overload of `boardToString()`.
+ */
+void boardToString(const Board& BOARD, string& content);
+
 /**
  * @brief Writes the Sudoku board to a file.
  *
- * Serializes the board into a formatted string and writes it to the specified file.
+ * Formats the board into a fixed-size buffer and writes it to the specified file.
+ * A confirmation line is printed unless quiet mode is on.
  *
  * @param BOARD A pointer to the 2D Sudoku board (int**).
  * @param filename Name of the file to write the board to.
@@ -65,6 +125,11 @@ void boardToString(int** BOARD, string& content);
  */
 bool writeSudokuToFile(int** BOARD, const string& filename);
 
+/**
+ * @brief `Board` overload of `writeSudokuToFile()`.
+ */
+bool writeSudokuToFile(const Board& BOARD, const string& filename);
+
 /**
  * @brief Replaces all occurrences of a character in a string.
  *
@@ -98,6 +163,11 @@ void extractNumbers(const string& input, vector<int>& numbers);
  */
 void fillBoard(const vector<int>& numbers, int** BOARD);
 
+/**
+ * @brief `Board` overload of `fillBoard()`; assumes the vector has at least 81 integers.
+ */
+void fillBoard(const vector<int>& numbers, Board& BOARD);
+
 /**
  * @brief Reads a Sudoku board from a file.
  *
@@ -109,6 +179,27 @@ void fillBoard(const vector<int>& numbers, int** BOARD);
  */
 int** readSudokuFromFile(const string& filename);
 
+/**
+ * @brief Reads a Sudoku board from a file into a flat `Board`.
+ *
+ * Uses the single-pass `SudokuParser`, so both the grid layout written by `writeSudokuToFile()`
+ * and the 81-character line layout are accepted. Only the first puzzle of the file is read.
+ *
+ * @param filename The path to the file containing the Sudoku puzzle.
+ * @param BOARD Receives the puzzle; left empty if the file is malformed.
+ * @return true if a complete puzzle was read, false otherwise (the reason is printed to cerr).
+ */
+bool readSudokuFromFile(const string& filename, Board& BOARD);
+
+/**
+ * @brief Streams every puzzle of a file (grid or line layout) into `boards`.
+ *
+ * @param filename The file to read.
+ * @param boards Puzzles are appended to this vector in file order.
+ * @return The number of malformed puzzles that were skipped (reported on cerr), or -1 if the file cannot be opened.
+ */
+int readAllSudokusFromFile(const string& filename, vector<Board>& boards);
+
 /**
  * @brief Checks if the provided Sudoku board is a valid solution.
  *
@@ -122,6 +213,14 @@ int** readSudokuFromFile(const string& filename);
  */
 bool checkIfSolutionIsValid(int** BOARD);
 
+/**
+ * @brief `Board` overload of `checkIfSolutionIsValid()`.
+ *
+ * Checks all 27 units with one 9-bit digit mask each in a single pass over the cells.
+ * `validateBatch()` (batch_solver.h) checks many boards at once with SIMD.
+ */
+bool checkIfSolutionIsValid(const Board& BOARD);
+
 /**
  * @brief Retrieves all Sudoku puzzle filenames in a given folder.
  *
@@ -144,31 +243,177 @@ vector<string> getAllSudokuInFolder(const string& folderPath);
  */
 void createAndSaveNPuzzles(const int& num_puzzles, const int& complexity_empty_boxes, const string& destination, const string& prefix);
 
+/**
+ * @brief Generates and saves multiple Sudoku puzzles on a worker pool with reproducible seeding.
+ *
+ * Puzzle `i` is generated by an engine seeded with `derivePuzzleSeed(master_seed, i)`, so the
+ * written corpus depends only on `master_seed` and not on `num_workers` or scheduling order.
+ *
+ * @param num_puzzles The number of puzzles to generate.
+ * @param complexity_empty_boxes Number of empty cells per puzzle.
+ * @param destination Folder where the puzzles will be saved.
+ * @param prefix Filename prefix for the saved puzzles.
+ * @param num_workers Worker threads: 1 = serial, <= 0 = one per hardware core.
+ * @param master_seed Seed of the whole generation job.
+ */
+void createAndSaveNPuzzles(const int& num_puzzles, const int& complexity_empty_boxes, const string& destination, const string& prefix, const int& num_workers, const uint64_t& master_seed);
+
+/**
+ * @brief Generates puzzles on a worker pool and hands them to any `BoardSink`.
+ *
+ * Core of the seeded `createAndSaveNPuzzles` variants: puzzle `i` is seeded with
+ * `derivePuzzleSeed(master_seed, i)` and written with `sink.write(i, board)`. Workers make
+ * chunks of puzzles through `runOrderedPipeline()` (see pipeline.h) and one thread writes them
+ * in index order, so a `StreamSink` never parks boards and memory stays bounded however large
+ * `num_puzzles` is. In quiet mode (see progress.h) per-board log lines are replaced by a
+ * periodic progress summary.
+ *
+ * @param num_puzzles The number of puzzles to generate.
+ * @param complexity_empty_boxes Number of empty cells per puzzle.
+ * @param sink Destination of the puzzles (directory, stream or corpus).
+ * @param num_workers Worker threads: 1 = serial, <= 0 = one per hardware core.
+ * @param master_seed Seed of the whole generation job.
+ */
+void createAndSaveNPuzzles(const int& num_puzzles, const int& complexity_empty_boxes, BoardSink& sink, const int& num_workers, const uint64_t& master_seed);
+
+/**
+ * @brief Generates puzzles whose difficulty grade lies in `target` and hands them to `sink`.
+ *
+ * Puzzles are served from `bank` while it has stock in the band (see puzzle_bank.h); the rest
+ * are made on demand with `generateBoardInBand()`, puzzle `i` seeded with
+ * `derivePuzzleSeed(master_seed, i)`. A puzzle that cannot be generated in the band is
+ * reported and skipped with `sink.skip(i)`, so a stream carries on with the next one.
+ *
+ * @param num_puzzles The number of puzzles to generate.
+ * @param target Difficulty band and blank limits.
+ * @param sink Destination of the puzzles (directory, stream or corpus).
+ * @param num_workers Worker threads: 1 = serial, <= 0 = one per hardware core.
+ * @param master_seed Seed of the whole generation job.
+ * @param bank Rated puzzles to serve first, or nullptr to always generate.
+ */
+void createAndSaveNPuzzles(const int& num_puzzles, const DifficultyTarget& target, BoardSink& sink, const int& num_workers, const uint64_t& master_seed, PuzzleBank* bank = nullptr);
+
+/**
+ * @brief Generates puzzles into a single binary corpus file instead of one text file per puzzle.
+ *
+ * Puzzle `i` is seeded with `derivePuzzleSeed(master_seed, i)` and stored as record `i`
+ * (after any records already in the file), so the corpus is identical for any worker count.
+ *
+ * @param num_puzzles The number of puzzles to generate.
+ * @param complexity_empty_boxes Number of empty cells per puzzle.
+ * @param corpus_path Corpus file to create or append to (see corpus.h).
+ * @param num_workers Worker threads: 1 = serial, <= 0 = one per hardware core.
+ * @param master_seed Seed of the whole generation job, also recorded in the corpus header.
+ */
+void createAndSaveNPuzzlesToCorpus(const int& num_puzzles, const int& complexity_empty_boxes, const string& corpus_path, const int& num_workers, const uint64_t& master_seed);
+
+/**
+ * @brief Solves every puzzle of a binary corpus and stores the solutions in another corpus.
+ *
+ * Record `i` of `destination` is the solution of record `i` of `source`; a puzzle that could
+ * not be solved leaves an all-zero record so the indexes stay aligned. Records are solved in
+ * groups of `BATCH_LANES` with `solveBatch()`.
+ *
+ * A puzzle whose search needs more than `node_budget` nodes is quarantined: it is skipped like
+ * an unsolvable one, its record index is reported on `cerr`, and the job moves on instead of
+ * letting one pathological board pin a worker.
+ *
+ * @param source Corpus file containing the puzzles.
+ * @param destination Corpus file to write the solutions to; an existing file is replaced.
+ * @param num_workers Worker threads: 1 = serial (default), <= 0 = one per hardware core.
+ * @param node_budget Search nodes allowed per puzzle, 0 = unlimited.
+ * @param validation Which solutions are checked before they are written.
+ * @param shard Slice of the job to run (see shard.h). A shard solves only its range of records
+ *        and writes them, renumbered from 0, to a fresh `shardSegmentPath(destination, shard)`
+ *        with a summary next to it; `mergeShardSegments()` joins the segments afterwards.
+ * @param engine Engine `solveBatch()` falls back to for boards propagation cannot finish.
+ * @param cache_capacity Solutions kept in a `SolutionCache` (see solution_cache.h), 0 = no cache.
+ *        Canonicalizing each puzzle for the lookup costs more than solving an average one, so
+ *        the cache only pays off when the input repeats puzzles or their symmetric variants.
+ * @return COMPLETE if every record was solved and written (see `SolveJobStatus`).
+ */
+SolveJobStatus solveAndSaveCorpus(const string& source, const string& destination, const int& num_workers = 1,
+                                  const uint64_t& node_budget = DEFAULT_PUZZLE_NODE_BUDGET,
+                                  const ValidationMode& validation = ValidationMode::FULL,
+                                  const ShardSpec& shard = ShardSpec(),
+                                  const SolverType& engine = SolverType::BITMASK,
+                                  const size_t& cache_capacity = 0);
+
 /**
  * @brief Solves and saves multiple Sudoku puzzles from a source folder.
  *
  * Reads unsolved puzzles from `source`, solves them, and saves the
- * solutions to `destination` with filenames prefixed by `prefix`.
+ * solutions to `destination` with filenames prefixed by `prefix`. Puzzles are solved in
+ * groups of `BATCH_LANES` with `solveBatch()`.
+ *
+ * The work runs as three overlapped stages (see pipeline.h): the calling thread streams the
+ * folder listing (`DirectorySource`) and reads the files, `num_workers` pool threads solve
+ * and validate, and a writer thread writes the solutions. Output names come from
+ * `getFileName()` with the index in the puzzle's own file name, so solution N belongs to
+ * puzzle N however many workers run. Files without a number in their name are numbered from
+ * `UNNUMBERED_INDEX_BASE` (see puzzle_source.h) and never overwrite a numbered file's solution.
  *
- * @param num_puzzles The number of puzzles to solve.
+ * @param num_puzzles The number of puzzles expected in `source` (used for progress reports).
  * @param source Folder containing unsolved puzzles.
  * @param destination Folder where solved puzzles will be saved.
  * @param prefix Filename prefix for the saved solutions.
+ * @param num_workers Solver threads (default 1), <= 0 = one per hardware core.
+ * @param node_budget Search nodes allowed per puzzle, 0 = unlimited. Puzzles over budget are
+ *        quarantined: not written, and their paths are reported on `cerr`.
+ * @param validation Which solutions are checked before they are written.
+ * @param shard Slice of the job to run (see shard.h). A shard solves only the files whose name
+ *        hashes to it and writes them to the `shardSegmentPath(destination, shard)` folder, with
+ *        a summary next to it; `mergeShardSegments()` joins the segments afterwards.
+ * @param engine Engine `solveBatch()` falls back to for boards propagation cannot finish.
+ * @param cache_capacity Solutions kept in a `SolutionCache` (see solution_cache.h), 0 = no cache.
+ *        Canonicalizing each puzzle for the lookup costs more than solving an average one, so
+ *        the cache only pays off when the input repeats puzzles or their symmetric variants.
+ * @return COMPLETE if every puzzle file of the shard was solved and written (see `SolveJobStatus`).
+ */
+SolveJobStatus solveAndSaveNPuzzles(const int& num_puzzles, const string& source, const string& destination, const string& prefix, const int& num_workers = 1,
+                                    const uint64_t& node_budget = DEFAULT_PUZZLE_NODE_BUDGET,
+                                    const ValidationMode& validation = ValidationMode::FULL,
+                                    const ShardSpec& shard = ShardSpec(),
+                                    const SolverType& engine = SolverType::BITMASK,
+                                    const size_t& cache_capacity = 0);
+
+/**
+ * @brief Solves a text file of puzzles (see sudoku_parser.h) into one text file of solutions.
+ *
+ * Runs the same overlapped read → solve → write stages as `solveAndSaveNPuzzles()`. The input
+ * may mix grid and line layout; the solutions are written through a `StreamSink` in `layout`,
+ * one per input puzzle and in input order. A puzzle that is malformed, unsolvable, quarantined
+ * or fails validation is written as an empty board, so solution `i` still belongs to puzzle `i`.
+ *
+ * @param source Text file of puzzles, or "-" for stdin.
+ * @param destination File for the solutions, or "-" for stdout.
+ * @param layout GRID or LINE layout of the solutions.
+ * @param num_puzzles The number of puzzles expected, for progress reports only (0 = unknown).
+ * @param num_workers Solver threads, <= 0 = one per hardware core.
+ * @param node_budget Search nodes allowed per puzzle, 0 = unlimited.
+ * @param validation Which solutions are checked before they are written.
+ * @param engine Engine `solveBatch()` falls back to for boards propagation cannot finish.
+ * @param cache_capacity Solutions kept in a `SolutionCache`, 0 = no cache (see `solveAndSaveCorpus()`).
+ * @return COMPLETE if every puzzle was solved and written (see `SolveJobStatus`).
  */
-void solveAndSaveNPuzzles(const int& num_puzzles, const string& source, const string& destination, const string& prefix);
+SolveJobStatus solveAndSaveStream(const string& source, const string& destination, const TextLayout& layout, const int& num_puzzles = 0,
+                                  const int& num_workers = 1, const uint64_t& node_budget = DEFAULT_PUZZLE_NODE_BUDGET,
+                                  const ValidationMode& validation = ValidationMode::FULL,
+                                  const SolverType& engine = SolverType::BITMASK, const size_t& cache_capacity = 0);
 
 /**
  * @brief Performs a deep copy of a 9x9 Sudoku board.
  *
  * @param original The original 9x9 Sudoku board to copy.
- * @return int** A pointer to the newly allocated deep-copied board.
+ * @return int** A pointer to the deep-copied board, taken from the board pool (see board_pool.h);
+ *         release it with `deallocateBoard()`.
  */
 int** deepCopyBoard(int** original);
 
 /**
- * @brief Compares the performance of solveBoard and efficientSolveBoard.
+ * @brief Compares the performance of solveBoard, efficientSolveBoard and solveBoardBitmask.
  *
- * Runs both solvers multiple times on generated Sudoku boards and prints
+ * Runs all solvers multiple times on generated Sudoku boards and prints
  * the average runtime for each solver.
  *
  * @param experiment_size Number of experiments to run.
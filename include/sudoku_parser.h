@@ -0,0 +1,99 @@
+/**
+ * @file sudoku_parser.h
+ * @brief Single-pass, regex-free parser for Sudoku puzzle text.
+ *
+ * Two layouts are accepted, and may be mixed within one stream:
+ * - Grid layout, as written by `writeSudokuToFile()`: nine rows of digits separated by spaces,
+ *   `|` box separators and `.....` separator lines, `-` or `0` for blanks.
+ * - Line layout: one puzzle per line as 81 characters, digits with `0`, `.` or `-` for blanks.
+ *
+ * The parser reads one line at a time from an `istream`, so a file holding millions of puzzles
+ * is never materialised as a single `std::string`, and every malformed puzzle is reported with
+ * its line number instead of being read past the end of a number vector.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_SUDOKU_PARSER_H
+#define SUDOKUPROJECT_SUDOKU_PARSER_H
+
+#include <istream>
+#include <string>
+#include "board.h"
+using namespace std;
+
+/**
+ * @brief Result of asking the parser for the next puzzle.
+ *
+ * - OK:        A puzzle was stored in the output board.
+ * - END:       The stream is exhausted.
+ * - MALFORMED: The current puzzle is invalid; `error()` says why. Parsing can continue.
+ */
+enum class ParseStatus { OK, END, MALFORMED };
+
+/**
+ * @brief Streams puzzles out of an input stream in either supported layout.
+ *
+ * Example:
+ * @code
+ * ifstream file("puzzles.txt");
+ * SudokuParser parser(file);
+ * Board board;
+ * ParseStatus status;
+ * while ((status = parser.next(board)) != ParseStatus::END) {
+ *     if (status == ParseStatus::OK) solve(board, SolverType::BITMASK);
+ *     else cerr << parser.error() << endl;
+ * }
+ * @endcode
+ */
+class SudokuParser {
+public:
+    explicit SudokuParser(istream& input) : in(input) {}
+
+    /**
+     * @brief Parses the next puzzle into `board`.
+     */
+    ParseStatus next(Board& board);
+
+    /**
+     * @brief Description of the last MALFORMED result, including the line number.
+     */
+    const string& error() const { return message; }
+
+    /**
+     * @brief Number of lines consumed so far.
+     */
+    int lineNumber() const { return line_number; }
+
+private:
+    istream& in;
+    string line;      // Reused for every line, so steady-state parsing does not allocate
+    string message;
+    int line_number = 0;
+
+    ParseStatus fail(const string& reason);
+};
+
+/**
+ * @brief Parses one puzzle in line layout (81 characters, `0`/`.`/`-` for blanks).
+ *
+ * Leading and trailing whitespace is ignored.
+ *
+ * @param text The line to parse.
+ * @param board Receives the puzzle.
+ * @return true if `text` is exactly one well-formed puzzle line.
+ */
+bool parseSudokuLine(const string& text, Board& board);
+
+/**
+ * @brief Formats a board in line layout (81 characters, `.` for blanks) into `content`.
+ *
+ * `content` is overwritten; its capacity is reused across calls.
+ */
+void boardToLine(const Board& board, string& content);
+
+#endif //SUDOKUPROJECT_SUDOKU_PARSER_H
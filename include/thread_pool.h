@@ -0,0 +1,103 @@
+/**
+ * @file thread_pool.h
+ * @brief Work-stealing thread pool used by the parallel batch modes.
+ *
+ * Each worker owns a task deque. Tasks submitted from outside the pool are spread
+ * round-robin over the deques; tasks submitted from inside a worker go to that worker's
+ * own deque. A worker pops from the back of its own deque and, when it runs dry, steals
+ * from the front of the others, so one slow puzzle never stalls a static partition.
+ *
+ * @author
+ * Keshav Bhandari
+ *
+ * @date
+ * February 7, 2025
+ */
+
+#ifndef SUDOKUPROJECT_THREAD_POOL_H
+#define SUDOKUPROJECT_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Returns the worker count to use when the caller asks for `requested` (<= 0 = all cores).
+ */
+int resolveWorkerCount(const int& requested);
+
+/**
+ * @brief Fixed-size pool of worker threads with per-worker deques and work stealing.
+ *
+ * Example:
+ * @code
+ * ThreadPool pool(8);
+ * for (int i = 0; i < 1000; i++) pool.submit([i]() { process(i); });
+ * pool.wait();  // Blocks until all 1000 tasks have finished
+ * @endcode
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Starts the workers.
+     *
+     * @param num_workers Number of threads; <= 0 uses `std::thread::hardware_concurrency()`.
+     */
+    explicit ThreadPool(const int& num_workers = 0);
+
+    /**
+     * @brief Finishes all queued tasks and joins the workers.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queues a task for execution on one of the workers.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Blocks until every task submitted so far has finished.
+     */
+    void wait();
+
+    /**
+     * @brief Number of worker threads.
+     */
+    int size() const { return static_cast<int>(workers.size()); }
+
+    /**
+     * @brief Index of the calling worker in [0, size()), or -1 when called from outside the pool.
+     */
+    static int currentWorker();
+
+private:
+    struct WorkerQueue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::atomic<int> queued{0};    // Tasks sitting in a deque
+    std::atomic<int> pending{0};   // Tasks submitted but not finished
+    std::atomic<unsigned> next_queue{0};
+    bool stopping = false;
+
+    std::mutex wake_lock;
+    std::condition_variable wake;
+    std::condition_variable done;
+
+    bool popTask(const int& worker, std::function<void()>& task);
+    void workerLoop(const int& worker);
+};
+
+#endif //SUDOKUPROJECT_THREAD_POOL_H
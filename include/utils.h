@@ -30,6 +30,8 @@ using namespace std;
  * ensures that there are no dangling pointers. It first checks if the BOARD is valid,
  * then deletes each row and finally deallocates the array of pointers itself. The
  * reference to the BOARD is set to nullptr to avoid further usage of the deleted memory.
+ * Boards from `getEmptyBoard()` are not freed but handed back to the calling thread's board
+ * pool (see board_pool.h).
  *
  * @param BOARD A reference to a pointer to a 2D array, which will be deallocated.
  * @param rows The number of rows in the 2D array, used to iterate through each row during deallocation.
@@ -59,7 +61,8 @@ void initDataFolder();
  *
  * Constructs a filename using a zero-padded index, a destination path, and a prefix.
  * The filename follows the pattern: `destination/XXXXprefix.txt`, where `XXXX` is the
- * zero-padded index (e.g., `0001puzzle.txt`).
+ * zero-padded index (e.g., `0001puzzle.txt`). Indexes of 10000 and above keep all their
+ * digits (e.g., `12345puzzle.txt`).
  *
  * @param index The numerical index to include in the filename.
  * @param destination The directory where the file will be saved.
@@ -0,0 +1,39 @@
+#!/bin/bash
+
+# Profile-guided optimization build:
+#   1. configure and build the instrumented `pgo-generate` preset,
+#   2. train it on the benchmark corpora plus a generate/solve round trip,
+#   3. rebuild the same directory with the `pgo-use` preset.
+# Usage: ./pgo.sh [path_to_project_dir]
+
+PROJECT_DIR="${1:-$(dirname "$0")}"
+cd "$PROJECT_DIR" || exit 1
+
+BUILD_PATH="cmake-build-pgo"
+PROFILE_DIR="$BUILD_PATH/pgo-profile"
+TRAIN_DIR="$BUILD_PATH/pgo-train"
+
+set -e
+
+# Stale counters from an older build would be merged into the new profile
+rm -rf "$PROFILE_DIR" "$TRAIN_DIR"
+cmake --preset pgo-generate
+cmake --build --preset pgo-generate --clean-first
+
+echo "------------TRAINING------------"
+mkdir -p "$TRAIN_DIR"
+"$BUILD_PATH/SudokuBenchmark" --corpora easy,medium,hard,17-clue --size 300 --warmup 1 --format csv --output "$TRAIN_DIR/bench.csv"
+"$BUILD_PATH/SudokuProject" generate --count 2000 --blanks 55 --format corpus --output "$TRAIN_DIR/puzzles.sdk" --seed 7 --quiet
+"$BUILD_PATH/SudokuProject" solve --input "$TRAIN_DIR/puzzles.sdk" --output "$TRAIN_DIR/solutions.sdk" --quiet
+
+# Clang writes raw profiles that have to be merged; GCC reads its .gcda files directly
+if compgen -G "$PROFILE_DIR/*.profraw" > /dev/null; then
+    llvm-profdata merge -output="$PROFILE_DIR/merged.profdata" "$PROFILE_DIR"/*.profraw
+fi
+
+cmake --preset pgo-use
+cmake --build --preset pgo-use --clean-first
+
+echo "----------------------------------------"
+echo "---------PGO BUILD DONE: $BUILD_PATH---------"
+echo "----------------------------------------"
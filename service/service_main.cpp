@@ -0,0 +1,13 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+// Command-line driver for the solver service, e.g.
+//   SudokuService --workers 8 < puzzles.txt > solutions.txt
+//   SudokuService --socket unix:/tmp/sudoku.sock
+// Same options as `SudokuProject serve`.
+//
+#include "../include/cli.h"
+
+int main(int argc, char** argv) {
+    return runServeCommand(vector<string>(argv + 1, argv + argc), "SudokuService");
+}
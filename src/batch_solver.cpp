@@ -0,0 +1,287 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/batch_solver.h"
+#include "../include/bitops.h"
+#include "../include/cell_selection.h"
+#include "../include/canonical.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+    // ---------------- Lane operations: one uint16 mask per board ----------------
+    // Every function has the same meaning for all three builds; only the width differs.
+
+#if defined(__AVX2__)
+    typedef __m256i Lanes;
+    inline Lanes loadLanes(const uint16_t* p) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+    inline void storeLanes(uint16_t* p, const Lanes& x) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), x); }
+    inline Lanes splat(const uint16_t& v) { return _mm256_set1_epi16(static_cast<short>(v)); }
+    inline Lanes laneAnd(const Lanes& a, const Lanes& b) { return _mm256_and_si256(a, b); }
+    inline Lanes laneOr(const Lanes& a, const Lanes& b) { return _mm256_or_si256(a, b); }
+    inline Lanes laneXor(const Lanes& a, const Lanes& b) { return _mm256_xor_si256(a, b); }
+    inline Lanes andNot(const Lanes& a, const Lanes& b) { return _mm256_andnot_si256(b, a); }  // a & ~b
+    inline Lanes isZero(const Lanes& x) { return _mm256_cmpeq_epi16(x, _mm256_setzero_si256()); }
+    inline Lanes minusOne(const Lanes& x) { return _mm256_sub_epi16(x, _mm256_set1_epi16(1)); }
+    inline bool anySet(const Lanes& x) { return !_mm256_testz_si256(x, x); }
+#elif defined(__SSE2__)
+    typedef __m128i Lanes;
+    inline Lanes loadLanes(const uint16_t* p) { return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+    inline void storeLanes(uint16_t* p, const Lanes& x) { _mm_store_si128(reinterpret_cast<__m128i*>(p), x); }
+    inline Lanes splat(const uint16_t& v) { return _mm_set1_epi16(static_cast<short>(v)); }
+    inline Lanes laneAnd(const Lanes& a, const Lanes& b) { return _mm_and_si128(a, b); }
+    inline Lanes laneOr(const Lanes& a, const Lanes& b) { return _mm_or_si128(a, b); }
+    inline Lanes laneXor(const Lanes& a, const Lanes& b) { return _mm_xor_si128(a, b); }
+    inline Lanes andNot(const Lanes& a, const Lanes& b) { return _mm_andnot_si128(b, a); }  // a & ~b
+    inline Lanes isZero(const Lanes& x) { return _mm_cmpeq_epi16(x, _mm_setzero_si128()); }
+    inline Lanes minusOne(const Lanes& x) { return _mm_sub_epi16(x, _mm_set1_epi16(1)); }
+    inline bool anySet(const Lanes& x) { return _mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_setzero_si128())) != 0xFFFF; }
+#else
+    struct Lanes { uint16_t v[BATCH_LANES]; };
+    inline Lanes loadLanes(const uint16_t* p) { Lanes x; for (int i = 0; i < BATCH_LANES; i++) x.v[i] = p[i]; return x; }
+    inline void storeLanes(uint16_t* p, const Lanes& x) { for (int i = 0; i < BATCH_LANES; i++) p[i] = x.v[i]; }
+    inline Lanes splat(const uint16_t& v) { Lanes x; for (int i = 0; i < BATCH_LANES; i++) x.v[i] = v; return x; }
+    inline Lanes laneAnd(const Lanes& a, const Lanes& b) { Lanes x; for (int i = 0; i < BATCH_LANES; i++) x.v[i] = a.v[i] & b.v[i]; return x; }
+    inline Lanes laneOr(const Lanes& a, const Lanes& b) { Lanes x; for (int i = 0; i < BATCH_LANES; i++) x.v[i] = a.v[i] | b.v[i]; return x; }
+    inline Lanes laneXor(const Lanes& a, const Lanes& b) { Lanes x; for (int i = 0; i < BATCH_LANES; i++) x.v[i] = a.v[i] ^ b.v[i]; return x; }
+    inline Lanes andNot(const Lanes& a, const Lanes& b) { Lanes x; for (int i = 0; i < BATCH_LANES; i++) x.v[i] = a.v[i] & ~b.v[i]; return x; }
+    inline Lanes isZero(const Lanes& a) { Lanes x; for (int i = 0; i < BATCH_LANES; i++) x.v[i] = a.v[i] == 0 ? 0xFFFF : 0; return x; }
+    inline Lanes minusOne(const Lanes& a) { Lanes x; for (int i = 0; i < BATCH_LANES; i++) x.v[i] = static_cast<uint16_t>(a.v[i] - 1); return x; }
+    inline bool anySet(const Lanes& a) { uint16_t any = 0; for (int i = 0; i < BATCH_LANES; i++) any |= a.v[i]; return any != 0; }
+#endif
+
+    // All ones in the lanes whose mask has exactly one candidate
+    inline Lanes singleLanes(const Lanes& x) {
+        return andNot(isZero(laneAnd(x, minusOne(x))), isZero(x));
+    }
+
+    /**
+     * Runs naked/hidden-single propagation on one batch until it reaches a fixed point.
+     * `dead` receives all ones in the lanes whose board was found to be contradictory.
+     * Returns the number of rounds over the 27 units.
+     */
+    int propagate(uint16_t (&cand)[81][BATCH_LANES], uint16_t (&dead)[BATCH_LANES]) {
+        const Lanes ALL = splat(ALL_DIGITS);
+        Lanes contradiction = splat(0);
+        bool changed = true;
+        int rounds = 0;
+        while (changed) {
+            rounds++;
+            Lanes diff = splat(0);
+            for (int u = 0; u < 27; u++) {
+                const uint8_t* unit = UNIT_TABLE.cells[u];
+                Lanes fixed = splat(0), clash = splat(0), once = splat(0), twice = splat(0);
+                for (int k = 0; k < 9; k++) {
+                    Lanes x = loadLanes(cand[unit[k]]);
+                    Lanes s = laneAnd(x, singleLanes(x));
+                    clash = laneOr(clash, laneAnd(fixed, s));
+                    fixed = laneOr(fixed, s);
+                    twice = laneOr(twice, laneAnd(once, x));
+                    once = laneOr(once, x);
+                }
+                contradiction = laneOr(contradiction, laneOr(clash, laneXor(once, ALL)));
+                Lanes exactly = andNot(once, twice);
+
+                for (int k = 0; k < 9; k++) {
+                    uint16_t* slot = cand[unit[k]];
+                    Lanes x = loadLanes(slot);
+                    Lanes single = singleLanes(x);
+                    // Open cells lose the digits fixed elsewhere in the unit
+                    Lanes next = andNot(x, andNot(fixed, single));
+                    // ...and collapse onto a digit that has no other place in the unit
+                    Lanes hidden = laneAnd(next, exactly);
+                    Lanes take = andNot(andNot(splat(0xFFFF), isZero(hidden)), single);
+                    next = laneOr(laneAnd(hidden, take), andNot(next, take));
+                    contradiction = laneOr(contradiction, isZero(next));
+                    diff = laneOr(diff, laneXor(next, x));
+                    storeLanes(slot, next);
+                }
+            }
+            // Masks only ever shrink, so this terminates
+            changed = anySet(diff);
+        }
+        storeLanes(dead, contradiction);
+        return rounds;
+    }
+
+    /**
+     * Solves one batch of at most BATCH_LANES boards. `finish` runs the fallback engine on a
+     * propagated board that is still open and returns its status; `status` receives one entry per board.
+     */
+    template <typename Recorder, typename Fallback>
+    int solveChunk(Board* boards, const int& count, SolveStatus* status, Recorder& recorder, const Fallback& finish) {
+        alignas(32) uint16_t cand[81][BATCH_LANES];
+        alignas(32) uint16_t dead[BATCH_LANES];
+        for (int cell = 0; cell < 81; cell++) {
+            for (int lane = 0; lane < BATCH_LANES; lane++) {
+                // Unused lanes carry an empty board, which propagation leaves untouched
+                int value = lane < count ? boards[lane].cells[cell] : 0;
+                cand[cell][lane] = value == 0 ? ALL_DIGITS : static_cast<uint16_t>(1u << (value - 1));
+            }
+        }
+
+        uint64_t start = recorder.clock();
+        recorder.propagated(propagate(cand, dead));
+        recorder.addPropagation(start);
+
+        int total = 0;
+        for (int lane = 0; lane < count; lane++) {
+            status[lane] = SolveStatus::UNSOLVABLE;
+            if (dead[lane] == 0) {
+                Board& board = boards[lane];
+                bool complete = true;
+                for (int cell = 0; cell < 81; cell++) {
+                    uint16_t mask = cand[cell][lane];
+                    bool single = (mask & (mask - 1)) == 0;
+                    board.cells[cell] = single ? static_cast<uint8_t>(bitToDigit(mask)) : 0;
+                    complete = complete && single;
+                }
+                // A board where every cell is fixed without a clash is a valid solution
+                status[lane] = complete ? SolveStatus::SOLVED : finish(board);
+            }
+            total += status[lane] == SolveStatus::SOLVED;
+        }
+        return total;
+    }
+
+    // Unbounded batch solve behind the bool overloads of solveBatch()
+    template <typename Recorder>
+    int solveBatchWith(Board* boards, const int& count, bool* solved, const SolverType& fallback, Recorder& recorder) {
+        auto finish = [&](Board& board) {
+            return solveWithRecorder(board, fallback, recorder) ? SolveStatus::SOLVED : SolveStatus::UNSOLVABLE;
+        };
+        SolveStatus status[BATCH_LANES];
+        int total = 0;
+        for (int start = 0; start < count; start += BATCH_LANES) {
+            int n = count - start < BATCH_LANES ? count - start : BATCH_LANES;
+            total += solveChunk(boards + start, n, status, recorder, finish);
+            if (solved == nullptr) continue;
+            for (int i = 0; i < n; i++) solved[start + i] = status[i] == SolveStatus::SOLVED;
+        }
+        return total;
+    }
+}
+
+const char* batchInstructionSet() {
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSE2__)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+int solveBatch(Board* boards, const int& count, bool* solved, const SolverType& fallback) {
+    NullRecorder recorder;
+    return solveBatchWith(boards, count, solved, fallback, recorder);
+}
+
+int solveBatch(Board* boards, const int& count, bool* solved, const SolverType& fallback, SolverStats& stats) {
+    CountingRecorder recorder(stats);
+    return solveBatchWith(boards, count, solved, fallback, recorder);
+}
+
+int solveBatch(Board* boards, const int& count, SolveStatus* status, const SolverType& fallback,
+               const SolveBudget& budget, SolverStats& stats, SolutionCache* cache) {
+    CountingRecorder recorder(stats);
+    // Each board that needs the fallback engine gets the full node budget of its own
+    auto finish = [&](Board& board) { return solveWithinBudget(board, fallback, budget, recorder); };
+    CanonicalBoard forms[BATCH_LANES];
+    Board pending[BATCH_LANES];
+    SolveStatus pending_status[BATCH_LANES];
+    int slot[BATCH_LANES];
+    int total = 0;
+    for (int start = 0; start < count; start += BATCH_LANES) {
+        int n = count - start < BATCH_LANES ? count - start : BATCH_LANES;
+
+        // Cache hits are answered directly; the misses are packed into one batch
+        int misses = 0;
+        for (int i = 0; i < n; i++) {
+            Board& board = boards[start + i];
+            if (cache != nullptr) {
+                canonicalForm(board, forms[misses]);
+                if (cache->find(forms[misses], board)) {
+                    status[start + i] = SolveStatus::SOLVED;
+                    total++;
+                    continue;
+                }
+            }
+            pending[misses] = board;
+            slot[misses++] = start + i;
+        }
+        if (misses == 0) continue;
+
+        total += solveChunk(pending, misses, pending_status, recorder, finish);
+        for (int k = 0; k < misses; k++) {
+            status[slot[k]] = pending_status[k];
+            if (pending_status[k] != SolveStatus::SOLVED) continue;  // Keep the input board
+            boards[slot[k]] = pending[k];
+            if (cache != nullptr) cache->store(forms[k], pending[k]);
+        }
+    }
+    return total;
+}
+
+namespace {
+    // Digit bit of every cell value, 0 for values that are not digits
+    struct DigitBitTable {
+        uint16_t bit[256];
+        DigitBitTable() : bit() {
+            for (int k = 1; k <= 9; k++) bit[k] = static_cast<uint16_t>(1u << (k - 1));
+        }
+    };
+    const DigitBitTable DIGIT_BITS;
+}
+
+int validateBatch(const Board* boards, const int& count, bool* valid) {
+    const Lanes ALL = splat(ALL_DIGITS);
+    alignas(32) uint16_t bits[81][BATCH_LANES];
+    alignas(32) uint16_t good[BATCH_LANES];
+    int total = 0;
+    for (int start = 0; start < count; start += BATCH_LANES) {
+        int n = count - start < BATCH_LANES ? count - start : BATCH_LANES;
+        // Digit k becomes bit k - 1; 0 and out-of-range values get no bit, so their units never complete
+        for (int i = 0; i < BATCH_LANES; i++) {
+            if (i >= n) {
+                for (int cell = 0; cell < 81; cell++) bits[cell][i] = 0;
+                continue;
+            }
+            const uint8_t* cells = boards[start + i].cells;
+            for (int cell = 0; cell < 81; cell++) bits[cell][i] = DIGIT_BITS.bit[cells[cell]];
+        }
+        Lanes complete = splat(0xFFFF);
+        for (int u = 0; u < 27; u++) {
+            const uint8_t* unit = UNIT_TABLE.cells[u];
+            Lanes seen = loadLanes(bits[unit[0]]);
+            for (int k = 1; k < 9; k++) seen = laneOr(seen, loadLanes(bits[unit[k]]));
+            complete = laneAnd(complete, isZero(laneXor(seen, ALL)));
+        }
+        storeLanes(good, complete);
+        for (int i = 0; i < n; i++) {
+            valid[start + i] = good[i] != 0;
+            total += valid[start + i];
+        }
+    }
+    return total;
+}
+
+int solveBatch(vector<Board>& boards, vector<bool>& solved, const SolverType& fallback) {
+    const int count = static_cast<int>(boards.size());
+    solved.assign(boards.size(), false);
+    NullRecorder recorder;
+    bool flags[BATCH_LANES];
+    int total = 0;
+    for (int start = 0; start < count; start += BATCH_LANES) {
+        int n = count - start < BATCH_LANES ? count - start : BATCH_LANES;
+        total += solveBatchWith(boards.data() + start, n, flags, fallback, recorder);
+        for (int i = 0; i < n; i++) solved[start + i] = flags[i];
+    }
+    return total;
+}
@@ -0,0 +1,291 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/benchmark.h"
+#include "../include/batch_solver.h"
+#include "../include/generator.h"
+#include "../include/sudoku_io.h"
+#include "../include/sudoku_parser.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace std;
+using namespace std::chrono;
+
+namespace {
+    // Minimal (17-given) puzzles from the public collection of Gordon Royle
+    const char* SEVENTEEN_CLUE_PUZZLES[] = {
+        "000000010400000000020000000000050407008000300001090000300400200050100000000806000",
+        "000000010400000000020000000000050604008000300001090000300400200050100000000807000",
+        "000000012000035000000600070700000300000400800100000000000120000080000040050000600",
+        "000000012003600000000007000410020000000500300700000600280000040000300500000000000",
+        "000000012008030000000000040120500000000004700060000000507000300000620000000100000",
+        "000000012040050000000009000070600400000100000000000050000087500601000300200000000",
+        "000000012050400000000000030700600400001000000000080000920000800000510700000003000",
+        "000000012300000060000040000900000500000001070020000000000350400001400800060000000",
+        "000000012400090000000000050070200000600000400000108000018000000000030700502000000",
+        "000000012500008000000700000600120000700000450000030000030000800000500700020000000",
+    };
+
+    // Well-known hand-made hard puzzles ("AI Escargot" and Arto Inkala's 2012 puzzle)
+    const char* HARD_PUZZLES[] = {
+        "100007090030020008009600500005300900010080002600004000300000010040000007007000300",
+        "800000000003600000070090200050007000000045700000100030001000068008500010090000400",
+    };
+
+    void generateCorpus(const uint64_t& seed, const int& size, const int& empty_boxes, vector<Board>& puzzles) {
+        RandomEngine engine;
+        for (int i = 0; i < size; i++) {
+            engine.seed(derivePuzzleSeed(seed, i));
+            Board board;
+            generateBoard(board, empty_boxes, engine, GenerationMode::UNIQUE);
+            puzzles.push_back(board);
+        }
+    }
+
+    void cycleFixedPuzzles(const char* const* list, const int& list_size, const int& size, vector<Board>& puzzles) {
+        for (int i = 0; i < size; i++) {
+            Board board;
+            parseSudokuLine(list[i % list_size], board);
+            puzzles.push_back(board);
+        }
+    }
+
+    bool isSlow(const SolverType& solver, const string& corpus) {
+        return solver == SolverType::BASIC && (corpus == "hard" || corpus == "17-clue");
+    }
+
+    string jsonEscape(const string& text) {
+        string escaped;
+        for (char ch : text) {
+            if (ch == '"' || ch == '\\') escaped += '\\';
+            escaped += ch;
+        }
+        return escaped;
+    }
+}
+
+string resultEngineName(const BenchmarkResult& result) {
+    return result.batched ? "batch" : solverName(result.solver);
+}
+
+const vector<string>& standardCorpusNames() {
+    static const vector<string> names = {"easy", "medium", "hard", "17-clue"};
+    return names;
+}
+
+bool buildStandardCorpus(const string& name, const uint64_t& seed, const int& size, BenchmarkCorpus& corpus) {
+    corpus.name = name;
+    corpus.puzzles.clear();
+    corpus.puzzles.reserve(size);
+    if (name == "easy") {
+        generateCorpus(seed, size, 30, corpus.puzzles);
+    } else if (name == "medium") {
+        generateCorpus(seed + 1, size, 45, corpus.puzzles);
+    } else if (name == "hard") {
+        // Mostly generated boards with the maximum number of blanks, plus the fixed hard puzzles
+        int fixed = min(size, static_cast<int>(sizeof(HARD_PUZZLES) / sizeof(HARD_PUZZLES[0])));
+        cycleFixedPuzzles(HARD_PUZZLES, fixed, fixed, corpus.puzzles);
+        generateCorpus(seed + 2, size - fixed, 81, corpus.puzzles);
+    } else if (name == "17-clue") {
+        cycleFixedPuzzles(SEVENTEEN_CLUE_PUZZLES, sizeof(SEVENTEEN_CLUE_PUZZLES) / sizeof(SEVENTEEN_CLUE_PUZZLES[0]),
+                          size, corpus.puzzles);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+LatencySummary summarizeLatencies(vector<double> latencies_us) {
+    LatencySummary summary;
+    summary.count = static_cast<int>(latencies_us.size());
+    if (latencies_us.empty()) return summary;
+    sort(latencies_us.begin(), latencies_us.end());
+    double total = 0;
+    for (const double& latency : latencies_us) total += latency;
+
+    auto percentile = [&](const double& p) {
+        size_t rank = static_cast<size_t>(p * (latencies_us.size() - 1) + 0.5);
+        return latencies_us[min(rank, latencies_us.size() - 1)];
+    };
+    summary.min_us = latencies_us.front();
+    summary.median_us = percentile(0.50);
+    summary.p99_us = percentile(0.99);
+    summary.max_us = latencies_us.back();
+    summary.mean_us = total / latencies_us.size();
+    summary.puzzles_per_sec = total > 0 ? latencies_us.size() / (total / 1e6) : 0;
+    return summary;
+}
+
+bool pinCurrentThread(const int& cpu) {
+#ifdef __linux__
+    if (cpu < 0) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+namespace {
+    BenchmarkResult runBatchBenchmark(const BenchmarkCorpus& corpus, const BenchmarkConfig& config) {
+        const int count = static_cast<int>(corpus.puzzles.size());
+        vector<Board> boards = corpus.puzzles;
+        bool solved[BATCH_LANES];
+        for (int start = 0; start < config.warmup && start < count; start += BATCH_LANES) {
+            solveBatch(boards.data() + start, min(BATCH_LANES, count - start), solved);
+        }
+
+        BenchmarkResult result;
+        result.corpus = corpus.name;
+        result.batched = true;
+        boards = corpus.puzzles;
+        vector<double> latencies;
+        latencies.reserve(count);
+        for (int start = 0; start < count; start += BATCH_LANES) {
+            const int n = min(BATCH_LANES, count - start);
+            auto begin = steady_clock::now();
+            solveBatch(boards.data() + start, n, solved);
+            auto end = steady_clock::now();
+            double per_puzzle = duration<double, micro>(end - begin).count() / n;
+            for (int k = 0; k < n; k++) {
+                latencies.push_back(per_puzzle);
+                if (!solved[k] || !checkIfSolutionIsValid(boards[start + k])) result.failures++;
+            }
+        }
+        result.latency = summarizeLatencies(latencies);
+
+        if (config.collect_stats) {
+            boards = corpus.puzzles;
+            for (int start = 0; start < count; start += BATCH_LANES) {
+                solveBatch(boards.data() + start, min(BATCH_LANES, count - start), solved, SolverType::BITMASK, result.stats);
+            }
+        }
+        return result;
+    }
+
+    double perPuzzle(const uint64_t& total, const BenchmarkResult& result) {
+        return result.latency.count > 0 ? static_cast<double>(total) / result.latency.count : 0;
+    }
+}
+
+vector<BenchmarkResult> runBenchmark(const BenchmarkConfig& config) {
+    if (config.cpu >= 0 && !pinCurrentThread(config.cpu)) {
+        cerr << "Could not pin benchmark thread to CPU " << config.cpu << endl;
+    }
+
+    vector<BenchmarkResult> results;
+    for (const string& name : config.corpora) {
+        BenchmarkCorpus corpus;
+        if (!buildStandardCorpus(name, config.seed, config.corpus_size, corpus)) {
+            cerr << "Unknown benchmark corpus: " << name << endl;
+            continue;
+        }
+        for (const SolverType& solver : config.solvers) {
+            if (isSlow(solver, name) && !config.include_slow) continue;
+
+            // Warm-up: caches, branch predictors and CPU frequency settle before timing
+            for (int i = 0; i < config.warmup && !corpus.puzzles.empty(); i++) {
+                Board board = corpus.puzzles[i % corpus.puzzles.size()];
+                solve(board, solver);
+            }
+
+            BenchmarkResult result;
+            result.corpus = name;
+            result.solver = solver;
+            vector<double> latencies;
+            latencies.reserve(corpus.puzzles.size());
+            for (const Board& puzzle : corpus.puzzles) {
+                Board board = puzzle;
+                auto start = steady_clock::now();
+                bool solved = solve(board, solver);
+                auto end = steady_clock::now();
+                latencies.push_back(duration<double, micro>(end - start).count());
+                if (!solved || !checkIfSolutionIsValid(board)) result.failures++;
+            }
+            result.latency = summarizeLatencies(latencies);
+
+            if (config.collect_stats) {
+                for (const Board& puzzle : corpus.puzzles) {
+                    Board board = puzzle;
+                    solve(board, solver, result.stats);
+                }
+            }
+            results.push_back(result);
+        }
+        if (config.include_batch) results.push_back(runBatchBenchmark(corpus, config));
+    }
+    return results;
+}
+
+bool parseReportFormat(const string& name, ReportFormat& format) {
+    if (name == "text") format = ReportFormat::TEXT;
+    else if (name == "json") format = ReportFormat::JSON;
+    else if (name == "csv") format = ReportFormat::CSV;
+    else return false;
+    return true;
+}
+
+void writeBenchmarkReport(const vector<BenchmarkResult>& results, const BenchmarkConfig& config, const ReportFormat& format, ostream& out) {
+    out << fixed << setprecision(3);
+    if (format == ReportFormat::CSV) {
+        out << "corpus,solver,count,failures,min_us,median_us,p99_us,max_us,mean_us,puzzles_per_sec,"
+               "nodes_per_puzzle,backtracks_per_puzzle,max_depth,propagations_per_puzzle\n";
+        for (const BenchmarkResult& r : results) {
+            out << r.corpus << ',' << resultEngineName(r) << ',' << r.latency.count << ',' << r.failures << ','
+                << r.latency.min_us << ',' << r.latency.median_us << ',' << r.latency.p99_us << ','
+                << r.latency.max_us << ',' << r.latency.mean_us << ',' << r.latency.puzzles_per_sec << ','
+                << perPuzzle(r.stats.nodes, r) << ',' << perPuzzle(r.stats.backtracks, r) << ','
+                << r.stats.max_depth << ',' << perPuzzle(r.stats.propagation_steps, r) << '\n';
+        }
+        return;
+    }
+
+    if (format == ReportFormat::JSON) {
+        out << "{\n  \"seed\": " << config.seed << ",\n  \"corpus_size\": " << config.corpus_size
+            << ",\n  \"warmup\": " << config.warmup << ",\n  \"batch_isa\": \"" << batchInstructionSet()
+            << "\",\n  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchmarkResult& r = results[i];
+            out << "    {\"corpus\": \"" << jsonEscape(r.corpus) << "\", \"solver\": \"" << resultEngineName(r)
+                << "\", \"count\": " << r.latency.count << ", \"failures\": " << r.failures
+                << ", \"min_us\": " << r.latency.min_us << ", \"median_us\": " << r.latency.median_us
+                << ", \"p99_us\": " << r.latency.p99_us << ", \"max_us\": " << r.latency.max_us
+                << ", \"mean_us\": " << r.latency.mean_us << ", \"puzzles_per_sec\": " << r.latency.puzzles_per_sec
+                << ", \"nodes_per_puzzle\": " << perPuzzle(r.stats.nodes, r)
+                << ", \"backtracks_per_puzzle\": " << perPuzzle(r.stats.backtracks, r)
+                << ", \"max_depth\": " << r.stats.max_depth
+                << ", \"propagations_per_puzzle\": " << perPuzzle(r.stats.propagation_steps, r)
+                << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+        return;
+    }
+
+    out << "====================== Benchmark (seed " << config.seed << ", " << config.corpus_size
+        << " puzzles per corpus, batch " << batchInstructionSet() << ") ======================\n";
+    out << left << setw(10) << "corpus" << setw(12) << "solver" << right << setw(8) << "fail"
+        << setw(12) << "min us" << setw(12) << "median us" << setw(12) << "p99 us" << setw(14) << "max us"
+        << setw(14) << "puzzles/s";
+    if (config.collect_stats) out << setw(12) << "nodes" << setw(12) << "backtracks" << setw(7) << "depth" << setw(12) << "props";
+    out << "\n";
+    for (const BenchmarkResult& r : results) {
+        out << left << setw(10) << r.corpus << setw(12) << resultEngineName(r) << right << setw(8) << r.failures
+            << setw(12) << r.latency.min_us << setw(12) << r.latency.median_us << setw(12) << r.latency.p99_us
+            << setw(14) << r.latency.max_us << setw(14) << r.latency.puzzles_per_sec;
+        if (config.collect_stats) {
+            out << setw(12) << perPuzzle(r.stats.nodes, r) << setw(12) << perPuzzle(r.stats.backtracks, r)
+                << setw(7) << r.stats.max_depth << setw(12) << perPuzzle(r.stats.propagation_steps, r);
+        }
+        out << "\n";
+    }
+}
@@ -0,0 +1,29 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/board.h"
+#include "../include/generator.h"
+
+Board toBoard(int** BOARD) {
+    Board board;
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+            board.cells[r * 9 + c] = static_cast<uint8_t>(BOARD[r][c]);
+        }
+    }
+    return board;
+}
+
+void copyToBoard(const Board& board, int** BOARD) {
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+            BOARD[r][c] = board.cells[r * 9 + c];
+        }
+    }
+}
+
+int** toIntBoard(const Board& board) {
+    int** BOARD = getEmptyBoard();
+    copyToBoard(board, BOARD);
+    return BOARD;
+}
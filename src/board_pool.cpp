@@ -0,0 +1,77 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/board_pool.h"
+#include <cstring>
+#include <new>
+
+using namespace std;
+
+namespace {
+    // Row pointers first, then the cells they point into
+    const size_t ROWS_BYTES = 9 * sizeof(int*);
+    const size_t BLOCK_BYTES = ROWS_BYTES + 81 * sizeof(int);
+
+    inline int* cellsOf(int** BOARD) {
+        return reinterpret_cast<int*>(reinterpret_cast<unsigned char*>(BOARD) + ROWS_BYTES);
+    }
+
+    struct ThreadBoardPool {
+        int** free_boards[BOARD_POOL_CAPACITY];
+        size_t count = 0;
+        uint64_t allocated = 0;
+        uint64_t reused = 0;
+
+        ~ThreadBoardPool() {
+            for (size_t i = 0; i < count; i++) ::operator delete(free_boards[i]);
+        }
+    };
+
+    ThreadBoardPool& threadPool() {
+        thread_local ThreadBoardPool pool;
+        return pool;
+    }
+}
+
+int** acquireBoard() {
+    ThreadBoardPool& pool = threadPool();
+    int** BOARD;
+    if (pool.count > 0) {
+        BOARD = pool.free_boards[--pool.count];
+        pool.reused++;
+    } else {
+        BOARD = static_cast<int**>(::operator new(BLOCK_BYTES));
+        int* cells = cellsOf(BOARD);
+        for (int r = 0; r < 9; r++) BOARD[r] = cells + r * 9;
+        pool.allocated++;
+    }
+    memset(cellsOf(BOARD), 0, 81 * sizeof(int));
+    return BOARD;
+}
+
+bool isPooledBoard(int** BOARD) {
+    if (BOARD == nullptr) return false;
+    const int* cells = cellsOf(BOARD);
+    for (int r = 0; r < 9; r++) {
+        if (BOARD[r] != cells + r * 9) return false;
+    }
+    return true;
+}
+
+bool releaseBoard(int**& BOARD) {
+    if (!isPooledBoard(BOARD)) return false;
+    ThreadBoardPool& pool = threadPool();
+    if (pool.count < BOARD_POOL_CAPACITY) pool.free_boards[pool.count++] = BOARD;
+    else ::operator delete(BOARD);
+    BOARD = nullptr;
+    return true;
+}
+
+BoardPoolStats boardPoolStats() {
+    const ThreadBoardPool& pool = threadPool();
+    BoardPoolStats stats;
+    stats.allocated = pool.allocated;
+    stats.reused = pool.reused;
+    stats.cached = pool.count;
+    return stats;
+}
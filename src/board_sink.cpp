@@ -0,0 +1,162 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/board_sink.h"
+#include "../include/utils.h"
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+int formatBoardGrid(const Board& board, char* out) {
+    char* p = out;
+    for (int i = 0; i < 9; i++) {
+        for (int j = 0; j < 9; j++) {
+            uint8_t value = board.cells[i * 9 + j];
+            *p++ = value == 0 ? '-' : static_cast<char>('0' + value);
+            if (j == 2 || j == 5) {
+                *p++ = ' ';
+                *p++ = '|';
+                *p++ = ' ';
+            } else {
+                *p++ = ' ';
+            }
+        }
+        if (i == 2 || i == 5) {
+            *p++ = '\n';
+            memset(p, '.', 21);
+            p += 21;
+        }
+        *p++ = '\n';
+    }
+    return static_cast<int>(p - out);
+}
+
+int formatBoardLine(const Board& board, char* out) {
+    for (int i = 0; i < 81; i++) {
+        out[i] = board.cells[i] == 0 ? '.' : static_cast<char>('0' + board.cells[i]);
+    }
+    out[81] = '\n';
+    return LINE_TEXT_SIZE;
+}
+
+// ========================= DirectorySink ==========================
+
+bool DirectorySink::write(const int& index, const Board& board) {
+    char text[GRID_TEXT_SIZE];
+    int length = formatBoardGrid(board, text);
+    string filename = getFileName(index, destination, prefix);
+    FILE* file = fopen(filename.c_str(), "wb");
+    if (file == nullptr) {
+        cerr << "Unable to open file: " << filename << endl;
+        return false;
+    }
+    bool ok = fwrite(text, 1, length, file) == static_cast<size_t>(length);
+    return (fclose(file) == 0) && ok;
+}
+
+string DirectorySink::describe(const int& index) const {
+    return getFileName(index, destination, prefix);
+}
+
+// ========================= StreamSink ==========================
+
+StreamSink::StreamSink(const string& path, const TextLayout& layout, const size_t& buffer_size)
+    : path(path), layout(layout), buffer(buffer_size < GRID_TEXT_SIZE ? GRID_TEXT_SIZE : buffer_size) {
+    if (path == "-") {
+        out = stdout;
+    } else {
+        out = fopen(path.c_str(), "wb");
+        owns_file = true;
+        if (out == nullptr) cerr << "Unable to open file: " << path << endl;
+    }
+}
+
+StreamSink::~StreamSink() {
+    flush();
+    if (owns_file && out != nullptr) fclose(out);
+}
+
+bool StreamSink::emit(const Board& board) {
+    size_t needed = layout == TextLayout::GRID ? GRID_TEXT_SIZE : LINE_TEXT_SIZE;
+    if (used + needed > buffer.size() && !flushLocked()) return false;
+    char* p = buffer.data() + used;
+    used += layout == TextLayout::GRID ? formatBoardGrid(board, p) : formatBoardLine(board, p);
+    return true;
+}
+
+void StreamSink::drainLocked() {
+    while (true) {
+        auto waiting = parked.find(next_index);
+        if (waiting != parked.end()) {
+            emit(waiting->second);
+            parked.erase(waiting);
+            next_index++;
+        } else if (skipped.erase(next_index)) {
+            next_index++;
+        } else {
+            return;
+        }
+    }
+}
+
+bool StreamSink::write(const int& index, const Board& board) {
+    lock_guard<mutex> guard(lock);
+    if (out == nullptr) return false;
+    if (index != next_index) {
+        parked[index] = board;
+        return true;
+    }
+    bool ok = emit(board);
+    next_index++;
+    drainLocked();
+    return ok;
+}
+
+void StreamSink::skip(const int& index) {
+    lock_guard<mutex> guard(lock);
+    if (index != next_index) {
+        skipped.insert(index);
+        return;
+    }
+    next_index++;
+    drainLocked();
+}
+
+bool StreamSink::flushLocked() {
+    if (out == nullptr) return false;
+    bool ok = fwrite(buffer.data(), 1, used, out) == used;
+    used = 0;
+    return (fflush(out) == 0) && ok;
+}
+
+bool StreamSink::flush() {
+    lock_guard<mutex> guard(lock);
+    return flushLocked();
+}
+
+string StreamSink::describe(const int& index) const {
+    return path + "#" + to_string(index);
+}
+
+// ========================= CorpusSink ==========================
+
+CorpusSink::CorpusSink(const string& path, const CorpusHeader& params) : path(path) {
+    open = writer.open(path, params);
+}
+
+CorpusSink::~CorpusSink() {
+    close();
+}
+
+bool CorpusSink::close() {
+    if (!open) return true;
+    open = false;
+    if (writer.close()) return true;
+    cerr << "Unable to finalize corpus: " << path << endl;
+    return false;
+}
+
+string CorpusSink::describe(const int& index) const {
+    return path + "#" + to_string(index);
+}
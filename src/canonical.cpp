@@ -0,0 +1,221 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/canonical.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    typedef array<uint8_t, 9> LineOrder;
+
+    // Line l of an oriented board: row l when !columns, column l when columns
+    inline uint8_t lineCell(const uint8_t* cells, const bool& columns, const int& l, const int& p) {
+        return columns ? cells[p * 9 + l] : cells[l * 9 + p];
+    }
+
+    // Invariant of a line under every symmetry that keeps it a line of the same kind: its sorted
+    // given counts per block (stack for a row, band for a column), total first, then how many of
+    // its givens lie on crossing lines with 0..9 givens
+    uint64_t lineKey(const uint8_t* cells, const bool& columns, const int& l, const int* crossing) {
+        int counts[3] = {0, 0, 0};
+        uint64_t histogram = 0;
+        for (int p = 0; p < 9; p++) {
+            if (lineCell(cells, columns, l, p) == 0) continue;
+            counts[p / 3]++;
+            histogram += uint64_t(1) << (4 * crossing[p]);
+        }
+        sort(counts, counts + 3);
+        uint64_t blocks = (counts[0] + counts[1] + counts[2]) * 64 + counts[0] * 16 + counts[1] * 4 + counts[2];
+        return (blocks << 40) | histogram;
+    }
+
+    // Insertion sort of a few ids by key; equal keys keep their order
+    template <typename Key>
+    void sortByKey(uint8_t* ids, const int& n, const Key* keys) {
+        for (int i = 1; i < n; i++) {
+            uint8_t id = ids[i];
+            int j = i;
+            for (; j > 0 && keys[id] < keys[ids[j - 1]]; j--) ids[j] = ids[j - 1];
+            ids[j] = id;
+        }
+    }
+
+    /**
+     * Slots 0..2 hold the block order, slots 3 + 3b .. 5 + 3b the line order inside block b.
+     * Each tie group is a run of slots whose ids have equal keys; only those runs are permuted.
+     */
+    struct OrderSearch {
+        uint8_t slots[12];
+        uint8_t group_start[12];
+        uint8_t group_size[12];
+        int groups = 0;
+    };
+
+    template <typename Key>
+    long long addTieGroups(OrderSearch& search, const int& first, const int& n, const Key* keys) {
+        long long combinations = 1;
+        for (int i = first; i < first + n;) {
+            int j = i + 1;
+            while (j < first + n && keys[search.slots[j]] == keys[search.slots[i]]) j++;
+            if (j - i > 1) {
+                // next_permutation needs every group to start in ascending id order
+                sort(search.slots + i, search.slots + j);
+                search.group_start[search.groups] = static_cast<uint8_t>(i);
+                search.group_size[search.groups++] = static_cast<uint8_t>(j - i);
+                for (int k = 2; k <= j - i; k++) combinations *= k;
+            }
+            i = j;
+        }
+        return combinations;
+    }
+
+    // Calls `visit` once for every combination of orderings within each tie group
+    template <typename Visit>
+    void permuteGroups(OrderSearch& search, const int& g, const Visit& visit) {
+        if (g == search.groups) {
+            visit();
+            return;
+        }
+        uint8_t* first = search.slots + search.group_start[g];
+        do {
+            permuteGroups(search, g + 1, visit);
+        } while (next_permutation(first, first + search.group_size[g]));
+    }
+
+    /**
+     * Lists every order of the rows (or columns) of an oriented board that sorts the bands (stacks)
+     * by key and the lines inside each by key. Returns false if there would be more than `limit`.
+     */
+    bool lineOrders(const uint8_t* cells, const bool& columns, const long long& limit, vector<LineOrder>& orders) {
+        orders.clear();
+        int crossing[9] = {0};
+        for (int l = 0; l < 9; l++) {
+            for (int p = 0; p < 9; p++) crossing[p] += lineCell(cells, columns, l, p) != 0;
+        }
+        uint64_t keys[9];
+        for (int l = 0; l < 9; l++) keys[l] = lineKey(cells, columns, l, crossing);
+
+        OrderSearch search;
+        long long total = 1;
+        // A block is keyed by its sorted line keys
+        array<uint64_t, 3> block_keys[3];
+        for (int b = 0; b < 3; b++) {
+            uint8_t* lines = search.slots + 3 + 3 * b;
+            for (int k = 0; k < 3; k++) lines[k] = static_cast<uint8_t>(b * 3 + k);
+            sortByKey(lines, 3, keys);
+            block_keys[b] = {keys[lines[0]], keys[lines[1]], keys[lines[2]]};
+            total *= addTieGroups(search, 3 + 3 * b, 3, keys);
+        }
+        for (int b = 0; b < 3; b++) search.slots[b] = static_cast<uint8_t>(b);
+        sortByKey(search.slots, 3, block_keys);
+        total *= addTieGroups(search, 0, 3, block_keys);
+        if (total > limit) return false;
+
+        permuteGroups(search, 0, [&]() {
+            LineOrder order;
+            for (int i = 0; i < 3; i++) {
+                const uint8_t* lines = search.slots + 3 + 3 * search.slots[i];
+                for (int k = 0; k < 3; k++) order[i * 3 + k] = lines[k];
+            }
+            orders.push_back(order);
+        });
+        return true;
+    }
+
+    // Fills the labels of digits missing from the board in increasing order, so `digits` is a permutation
+    void completeLabels(uint8_t (&digits)[10], int next) {
+        for (int d = 1; d <= 9; d++) {
+            if (digits[d] == 0) digits[d] = static_cast<uint8_t>(next++);
+        }
+    }
+}
+
+void transformBoard(const Board& input, const BoardTransform& transform, Board& output) {
+    for (int i = 0; i < 9; i++) {
+        for (int j = 0; j < 9; j++) {
+            int r = transform.rows[i], c = transform.cols[j];
+            uint8_t value = transform.transpose ? input.cells[c * 9 + r] : input.cells[r * 9 + c];
+            output.cells[i * 9 + j] = transform.digits[value];
+        }
+    }
+}
+
+void untransformBoard(const Board& input, const BoardTransform& transform, Board& output) {
+    uint8_t inverse[10];
+    for (int d = 0; d <= 9; d++) inverse[transform.digits[d]] = static_cast<uint8_t>(d);
+    for (int i = 0; i < 9; i++) {
+        for (int j = 0; j < 9; j++) {
+            int r = transform.rows[i], c = transform.cols[j];
+            uint8_t value = inverse[input.cells[i * 9 + j]];
+            if (transform.transpose) output.cells[c * 9 + r] = value;
+            else output.cells[r * 9 + c] = value;
+        }
+    }
+}
+
+bool canonicalForm(const Board& board, CanonicalBoard& form) {
+    uint8_t oriented[2][81];
+    memcpy(oriented[0], board.cells, 81);
+    for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) oriented[1][r * 9 + c] = board.cells[c * 9 + r];
+    }
+
+    // Rows of the transposed board are the columns of the board, so two searches cover both
+    // orientations; reused between calls so the common case does not allocate
+    thread_local vector<LineOrder> row_orders, col_orders;
+    long long arrangements = CANONICAL_SEARCH_LIMIT + 1;
+    if (lineOrders(board.cells, false, CANONICAL_SEARCH_LIMIT, row_orders) &&
+        lineOrders(board.cells, true, CANONICAL_SEARCH_LIMIT, col_orders)) {
+        arrangements = 2 * static_cast<long long>(row_orders.size()) * col_orders.size();
+    }
+    if (arrangements > CANONICAL_SEARCH_LIMIT) {
+        // Too regular to search: the board stands for itself
+        form.board = board;
+        form.transform = BoardTransform();
+        form.exact = false;
+        return false;
+    }
+
+    uint8_t* best = form.board.cells;
+    bool have_best = false;
+    uint8_t candidate[81];
+    for (int t = 0; t < 2; t++) {
+        const uint8_t* cells = oriented[t];
+        for (const LineOrder& rows : t == 0 ? row_orders : col_orders) {
+            for (const LineOrder& cols : t == 0 ? col_orders : row_orders) {
+                // Relabel digits by first appearance; stop as soon as the prefix is worse than the best
+                uint8_t digits[10] = {0};
+                int next = 1;
+                bool smaller = !have_best;
+                bool worse = false;
+                for (int k = 0; k < 81 && !worse; k++) {
+                    uint8_t value = cells[rows[k / 9] * 9 + cols[k % 9]];
+                    if (value != 0) {
+                        if (digits[value] == 0) digits[value] = static_cast<uint8_t>(next++);
+                        value = digits[value];
+                    }
+                    if (!smaller) {
+                        if (value > best[k]) worse = true;
+                        else if (value < best[k]) smaller = true;
+                    }
+                    candidate[k] = value;
+                }
+                if (worse || (!smaller && have_best)) continue;
+
+                memcpy(best, candidate, 81);
+                have_best = true;
+                form.transform.transpose = t == 1;
+                memcpy(form.transform.rows, rows.data(), 9);
+                memcpy(form.transform.cols, cols.data(), 9);
+                completeLabels(digits, next);
+                memcpy(form.transform.digits, digits, 10);
+            }
+        }
+    }
+    form.exact = true;
+    return true;
+}
@@ -0,0 +1,27 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/cell_selection.h"
+
+bool CandidateTracker::init(const Board& BOARD) {
+    for (int i = 0; i < 9; i++) rows[i] = cols[i] = boxes[i] = 0;
+    for (int n = 0; n <= 9; n++) buckets[n][0] = buckets[n][1] = 0;
+    open[0] = open[1] = 0;
+
+    for (int cell = 0; cell < 81; cell++) {
+        counts[cell] = 0;
+        int k = BOARD.cells[cell];
+        if (k == 0) continue;
+        if (k > 9) return false;
+        uint16_t bit = 1u << (k - 1);
+        if ((rows[PEER_TABLE.row[cell]] | cols[PEER_TABLE.col[cell]] | boxes[PEER_TABLE.box[cell]]) & bit) return false;
+        rows[PEER_TABLE.row[cell]] |= bit;
+        cols[PEER_TABLE.col[cell]] |= bit;
+        boxes[PEER_TABLE.box[cell]] |= bit;
+    }
+
+    for (int cell = 0; cell < 81; cell++) {
+        if (BOARD.cells[cell] == 0) addOpen(cell, countBits(candidates(cell)));
+    }
+    return true;
+}
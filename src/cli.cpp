@@ -0,0 +1,656 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/cli.h"
+#include "../include/benchmark.h"
+#include "../include/board_sink.h"
+#include "../include/corpus.h"
+#include "../include/metrics.h"
+#include "../include/progress.h"
+#include "../include/puzzle_bank.h"
+#include "../include/shard.h"
+#include "../include/solver_service.h"
+#include "../include/sudoku_io.h"
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+
+using namespace std;
+
+namespace {
+    const string DEFAULT_PUZZLE_FOLDER = "data/puzzles/";
+    const string DEFAULT_SOLUTION_FOLDER = "data/solutions/";
+    const string DEFAULT_PUZZLE_PREFIX = "PUZZLE";
+    const string DEFAULT_SOLUTION_PREFIX = "SOLUTION";
+    const int DEFAULT_GENERATE_COUNT = 10;
+    const int DEFAULT_GENERATE_BLANKS = 45;
+
+    // Walks the arguments of one command; a missing or malformed value ends the process with 2
+    struct Flags {
+        const vector<string>& args;
+        size_t position = 0;
+        string arg;
+
+        explicit Flags(const vector<string>& args) : args(args) {}
+
+        bool next() {
+            if (position >= args.size()) return false;
+            arg = args[position++];
+            return true;
+        }
+
+        string value() {
+            if (position >= args.size()) {
+                cerr << "Missing value for " << arg << endl;
+                exit(2);
+            }
+            return args[position++];
+        }
+
+        long long integer(const long long& lowest) {
+            const string text = value();
+            char* end = nullptr;
+            const long long number = strtoll(text.c_str(), &end, 10);
+            if (text.empty() || *end != '\0' || number < lowest) invalid(text);
+            return number;
+        }
+
+        uint64_t count() {
+            const string text = value();
+            char* end = nullptr;
+            const unsigned long long number = strtoull(text.c_str(), &end, 10);
+            if (text.empty() || text[0] == '-' || *end != '\0') invalid(text);
+            return number;
+        }
+
+        void invalid(const string& text) const {
+            cerr << "Invalid value for " << arg << ": " << text << endl;
+            exit(2);
+        }
+    };
+
+    // --metrics PATH and --metrics-interval N, shared by the commands that run long jobs
+    struct MetricsFlags {
+        string path;
+        long long interval = 5;
+
+        bool parse(Flags& flags) {
+            if (flags.arg == "--metrics") path = flags.value();
+            else if (flags.arg == "--metrics-interval") interval = flags.integer(1);
+            else return false;
+            return true;
+        }
+
+        // Turns the stage timers on and starts rewriting the file, if --metrics was given
+        unique_ptr<MetricsExporter> start() const {
+            if (path.empty()) return nullptr;
+            setMetricsEnabled(true);
+            return unique_ptr<MetricsExporter>(new MetricsExporter(path, static_cast<double>(interval)));
+        }
+    };
+
+    const char* METRICS_USAGE =
+        "  --metrics PATH     Rewrite stage latency histograms and progress to PATH (Prometheus text)\n"
+        "  --metrics-interval N  Seconds between rewrites of --metrics (default 5)\n";
+
+    vector<string> splitList(const string& text) {
+        vector<string> items;
+        stringstream stream(text);
+        string item;
+        while (getline(stream, item, ',')) {
+            if (!item.empty()) items.push_back(item);
+        }
+        return items;
+    }
+
+    // Puts cout back when a command that pointed it elsewhere returns
+    struct LogRedirect {
+        streambuf* saved = nullptr;
+        ~LogRedirect() {
+            if (saved != nullptr) cout.rdbuf(saved);
+        }
+    };
+
+    string asFolder(string path) {
+        if (!path.empty() && path.back() != '/') path += '/';
+        return path;
+    }
+
+    uint64_t randomSeed() {
+        random_device device;
+        return (static_cast<uint64_t>(device()) << 32) ^ device();
+    }
+
+    void printCommands() {
+        cout << "Usage: SudokuProject <command> [options]\n"
+             << "Commands:\n"
+             << "  generate   Generate puzzles into files, a stream or a corpus\n"
+             << "  solve      Solve a puzzle folder or corpus, or one shard of it\n"
+             << "  bench      Run the solver benchmark\n"
+             << "  serve      Solve puzzles streamed over stdin/stdout or a socket\n"
+             << "  compare    Time the solvers against each other on generated puzzles\n"
+             << "Run 'SudokuProject <command> --help' for the options of a command.\n";
+    }
+
+    void printGenerateUsage() {
+        cout << "Usage: SudokuProject generate [options]\n"
+             << "  --count N          Puzzles to generate (default " << DEFAULT_GENERATE_COUNT << ")\n"
+             << "  --blanks N         Blank cells per puzzle (default " << DEFAULT_GENERATE_BLANKS << "); with\n"
+             << "                     --difficulty, the blanks a puzzle needs before it may stop early\n"
+             << "  --difficulty BAND  Grade or range of grades, e.g. hard or medium-expert\n"
+             << "  --bank DIR         Serve --difficulty puzzles from the rated bank in DIR first\n"
+             << "  --stock N          Top each grade of the band in the bank up to N puzzles first\n"
+             << "  --seed N           Master seed (default random, printed to stderr)\n"
+             << "  --workers N        Generator threads, 0 = all cores (default 0)\n"
+             << "  --format F         files, grid, line or corpus (default files)\n"
+             << "  --output PATH      Folder for files (default " << DEFAULT_PUZZLE_FOLDER << "), file or - for\n"
+             << "                     grid and line, corpus file for corpus\n"
+             << "  --prefix NAME      File name prefix for --format files (default " << DEFAULT_PUZZLE_PREFIX << ")\n"
+             << "  --quiet            Periodic progress instead of a line per puzzle\n"
+             << METRICS_USAGE;
+    }
+
+    void printSolveUsage() {
+        cout << "Usage: SudokuProject solve [options]\n"
+             << "  --input PATH       Puzzle folder, corpus or text file, - = stdin (default " << DEFAULT_PUZZLE_FOLDER << ")\n"
+             << "  --output PATH      Solution folder, corpus or text file, - = stdout (default "
+             << DEFAULT_SOLUTION_FOLDER << " for files, stdout for grid and line)\n"
+             << "  --format F         files, grid, line or corpus, for input and output alike (default:\n"
+             << "                     files for a folder, corpus for a corpus file, line otherwise)\n"
+             << "  --prefix NAME      Solution file prefix for folders (default " << DEFAULT_SOLUTION_PREFIX << ")\n"
+             << "  --count N          Puzzles expected, for progress (default: files in the folder)\n"
+             << "  --engine NAME      Fallback engine (basic, efficient, bitmask, dlx); default bitmask\n"
+             << "  --workers N        Solver threads, 0 = all cores (default 0)\n"
+             << "  --node-budget N    Search nodes per puzzle before it is quarantined, 0 = unlimited\n"
+             << "                     (default " << DEFAULT_PUZZLE_NODE_BUDGET << ")\n"
+             << "  --validate MODE    full, sampled or none (default full)\n"
+             << "  --cache N          Solutions kept for repeated or symmetric puzzles, 0 = off (default 0);\n"
+             << "                     pays off only when the input repeats puzzles\n"
+             << "  --shard I/N        Solve only shard I of N (0 <= I < N) into a segment of --output\n"
+             << "  --merge N          Join the N shard segments of --output instead of solving\n"
+             << "  --quiet            Periodic progress instead of a line per puzzle\n"
+             << METRICS_USAGE
+             << "Exit status: 0 all puzzles solved and written, 1 the job failed, 2 usage error,\n"
+             << "3 some puzzles were malformed, unsolved, quarantined or not written\n";
+    }
+
+    // True if `path` starts with the corpus magic
+    bool looksLikeCorpus(const string& path) {
+        ifstream file(path, ios::binary);
+        uint32_t magic = 0;
+        return file.read(reinterpret_cast<char*>(&magic), sizeof(magic)) && magic == CORPUS_MAGIC;
+    }
+
+    int exitCode(const SolveJobStatus& status) {
+        switch (status) {
+            case SolveJobStatus::COMPLETE: return 0;
+            case SolveJobStatus::INCOMPLETE: return 3;
+            case SolveJobStatus::FAILED: return 1;
+        }
+        return 1;
+    }
+
+    void printBenchUsage(const string& program) {
+        cout << "Usage: " << program << " [options]\n"
+             << "  --engines LIST    Comma-separated engines (basic, efficient, bitmask, dlx); default all\n"
+             << "  --corpora LIST    Comma-separated corpora (easy, medium, hard, 17-clue); default all\n"
+             << "  --size N          Puzzles per corpus (default 200)\n"
+             << "  --warmup N        Untimed solves per engine and corpus (default 20)\n"
+             << "  --seed N          Master seed for generated corpora (default 2025)\n"
+             << "  --cpu N           Pin the benchmark thread to CPU N\n"
+             << "  --format F        text, json or csv (default text)\n"
+             << "  --output PATH     Write the report to PATH instead of stdout\n"
+             << "  --include-slow    Also run the basic solver on hard and 17-clue\n"
+             << "  --no-batch        Skip the solveBatch() runs\n"
+             << "  --no-stats        Skip the untimed pass that counts search nodes\n";
+    }
+
+    void printServeUsage(const string& program) {
+        cout << "Usage: " << program << " [options]\n"
+             << "Reads puzzles (81 characters per line) from stdin and writes one line per puzzle:\n"
+             << "the solution, 'unsolvable', 'budget-exceeded' or 'error: <reason>'.\n"
+             << "  --socket ADDR      Serve unix:PATH or tcp:[HOST:]PORT instead of stdin/stdout\n"
+             << "  --workers N        Solver threads (default all cores)\n"
+             << "  --engine NAME      Fallback engine (basic, efficient, bitmask, dlx); default bitmask\n"
+             << "  --node-budget N    Search nodes per puzzle before giving up, 0 = unlimited (default "
+             << DEFAULT_PUZZLE_NODE_BUDGET << ")\n"
+             << "  --cache N          Solutions kept for repeated puzzles, 0 = off (default "
+             << DEFAULT_SOLUTION_CACHE_CAPACITY << ")\n"
+             << "  --chunk N          Puzzles per worker task (default 64); --batch is the same\n"
+             << "  --quiet            Do not print the summary to stderr\n"
+             << METRICS_USAGE
+             << "  --metrics-socket ADDR  Serve the metrics over HTTP on unix:PATH or tcp:[HOST:]PORT\n";
+    }
+
+    void printCompareUsage() {
+        cout << "Usage: SudokuProject compare [options]\n"
+             << "Without options, runs the classic series: 10 x 64, 100 x 45, 1000 x 32 and 10000 x 16 blanks.\n"
+             << "  --size N           Puzzles in a single comparison\n"
+             << "  --blanks N         Blank cells per puzzle of that comparison (default 45)\n";
+    }
+
+    int unknownOption(const string& arg, void (*usage)()) {
+        cerr << "Unknown option: " << arg << endl;
+        usage();
+        return 2;
+    }
+
+    bool parseEngine(const string& name, SolverType& engine) {
+        if (parseSolverType(name, engine)) return true;
+        cerr << "Unknown engine: " << name << endl;
+        return false;
+    }
+}
+
+int runCli(int argc, char** argv) {
+    if (argc < 2) {
+        printCommands();
+        return 2;
+    }
+    const string command = argv[1];
+    const vector<string> args(argv + 2, argv + argc);
+    if (command == "generate") return runGenerateCommand(args);
+    if (command == "solve") return runSolveCommand(args);
+    if (command == "bench") return runBenchCommand(args);
+    if (command == "serve") return runServeCommand(args);
+    if (command == "compare") return runCompareCommand(args);
+    if (command == "help" || command == "--help" || command == "-h") {
+        printCommands();
+        return 0;
+    }
+    cerr << "Unknown command: " << command << endl;
+    printCommands();
+    return 2;
+}
+
+int runGenerateCommand(const vector<string>& args) {
+    int count = DEFAULT_GENERATE_COUNT;
+    int blanks = DEFAULT_GENERATE_BLANKS;
+    bool blanks_given = false;
+    int workers = 0;
+    int stock = 0;
+    uint64_t seed = 0;
+    bool seeded = false;
+    string band, bank_folder, format = "files", output, prefix = DEFAULT_PUZZLE_PREFIX;
+    MetricsFlags metrics;
+
+    Flags flags{args};
+    while (flags.next()) {
+        const string& arg = flags.arg;
+        if (arg == "--count") {
+            count = static_cast<int>(flags.integer(0));
+        } else if (arg == "--blanks") {
+            blanks = static_cast<int>(flags.integer(1));
+            blanks_given = true;
+            if (blanks > 81) flags.invalid(to_string(blanks));
+        } else if (arg == "--difficulty") {
+            band = flags.value();
+        } else if (arg == "--bank") {
+            bank_folder = flags.value();
+        } else if (arg == "--stock") {
+            stock = static_cast<int>(flags.integer(0));
+        } else if (arg == "--seed") {
+            seed = flags.count();
+            seeded = true;
+        } else if (arg == "--workers") {
+            workers = static_cast<int>(flags.integer(0));
+        } else if (arg == "--format") {
+            format = flags.value();
+        } else if (arg == "--output") {
+            output = flags.value();
+        } else if (arg == "--prefix") {
+            prefix = flags.value();
+        } else if (arg == "--quiet") {
+            setQuietMode(true);
+        } else if (metrics.parse(flags)) {
+        } else if (arg == "--help" || arg == "-h") {
+            printGenerateUsage();
+            return 0;
+        } else {
+            return unknownOption(arg, printGenerateUsage);
+        }
+    }
+
+    DifficultyTarget target;
+    const bool by_grade = !band.empty();
+    if (by_grade && !parseDifficultyTarget(band, target)) {
+        cerr << "Unknown difficulty band: " << band << endl;
+        return 2;
+    }
+    if (blanks_given) target.min_blanks = blanks;
+    if (!bank_folder.empty() && !by_grade) {
+        cerr << "--bank needs --difficulty" << endl;
+        return 2;
+    }
+    if (!seeded) seed = randomSeed();
+    if (!isQuietMode()) cerr << "seed: " << seed << endl;
+
+    LogRedirect log_redirect;
+    unique_ptr<BoardSink> sink;
+    if (format == "files") {
+        output = asFolder(output.empty() ? DEFAULT_PUZZLE_FOLDER : output);
+        error_code error;
+        filesystem::create_directories(output, error);
+        sink.reset(new DirectorySink(output, prefix));
+    } else if (format == "grid" || format == "line") {
+        if (output.empty()) output = "-";
+        // The sink writes to stdio's stdout; send cout's log lines to stderr so they stay out of the puzzles
+        if (output == "-") log_redirect.saved = cout.rdbuf(cerr.rdbuf());
+        StreamSink* stream = new StreamSink(output, format == "grid" ? TextLayout::GRID : TextLayout::LINE);
+        sink.reset(stream);
+        if (!stream->isOpen()) return 1;
+    } else if (format == "corpus") {
+        if (output.empty()) {
+            cerr << "--format corpus needs --output" << endl;
+            return 2;
+        }
+        CorpusHeader params;
+        params.empty_boxes = by_grade ? 0 : blanks;
+        params.flags = CORPUS_FLAG_UNIQUE;
+        params.master_seed = seed;
+        CorpusSink* corpus = new CorpusSink(output, params);
+        sink.reset(corpus);
+        if (!corpus->isOpen()) return 1;
+    } else {
+        cerr << "Unknown format: " << format << endl;
+        return 2;
+    }
+
+    unique_ptr<PuzzleBank> bank;
+    if (!bank_folder.empty()) {
+        bank.reset(new PuzzleBank(bank_folder));
+        if (!bank->load()) return 1;
+        if (stock > 0) {
+            // A seed of its own, so stocked puzzles do not repeat the ones generated below
+            const int added = bank->stock(target, stock, workers, derivePuzzleSeed(seed, -1));
+            cerr << "bank: " << added << " puzzles added to " << bank_folder << endl;
+        }
+    }
+
+    unique_ptr<MetricsExporter> exporter = metrics.start();
+    if (by_grade) createAndSaveNPuzzles(count, target, *sink, workers, seed, bank.get());
+    else createAndSaveNPuzzles(count, blanks, *sink, workers, seed);
+    sink.reset();  // Finalizes stream and corpus output
+    if (exporter) {
+        exporter.reset();  // Writes the final totals
+        printStageSummary(collectMetrics(), cout);
+    }
+    if (bank && !bank->save()) return 1;
+    return 0;
+}
+
+int runSolveCommand(const vector<string>& args) {
+    string input = DEFAULT_PUZZLE_FOLDER, output, prefix = DEFAULT_SOLUTION_PREFIX, format;
+    int count = -1;
+    int workers = 0;
+    int merge = 0;
+    uint64_t node_budget = DEFAULT_PUZZLE_NODE_BUDGET;
+    size_t cache_capacity = 0;
+    ValidationMode validation = ValidationMode::FULL;
+    SolverType engine = SolverType::BITMASK;
+    ShardSpec shard;
+    MetricsFlags metrics;
+
+    Flags flags{args};
+    while (flags.next()) {
+        const string& arg = flags.arg;
+        if (arg == "--input") {
+            input = flags.value();
+        } else if (arg == "--output") {
+            output = flags.value();
+        } else if (arg == "--prefix") {
+            prefix = flags.value();
+        } else if (arg == "--format") {
+            format = flags.value();
+        } else if (arg == "--count") {
+            count = static_cast<int>(flags.integer(0));
+        } else if (arg == "--engine") {
+            if (!parseEngine(flags.value(), engine)) return 2;
+        } else if (arg == "--workers") {
+            workers = static_cast<int>(flags.integer(0));
+        } else if (arg == "--node-budget") {
+            node_budget = flags.count();
+        } else if (arg == "--validate") {
+            const string name = flags.value();
+            if (!parseValidationMode(name, validation)) {
+                cerr << "Unknown validation mode: " << name << endl;
+                return 2;
+            }
+        } else if (arg == "--cache") {
+            cache_capacity = flags.count();
+        } else if (arg == "--shard") {
+            const string text = flags.value();
+            if (!parseShardSpec(text, shard)) flags.invalid(text);
+        } else if (arg == "--merge") {
+            merge = static_cast<int>(flags.integer(1));
+        } else if (arg == "--quiet") {
+            setQuietMode(true);
+        } else if (metrics.parse(flags)) {
+        } else if (arg == "--help" || arg == "-h") {
+            printSolveUsage();
+            return 0;
+        } else {
+            return unknownOption(arg, printSolveUsage);
+        }
+    }
+
+    if (merge > 0) {
+        if (output.empty()) output = DEFAULT_SOLUTION_FOLDER;
+        ShardSummary summary;
+        if (!mergeShardSegments(output, merge, &summary)) return 1;
+        cout << "Merged " << merge << " shards into " << output << endl;
+        printShardSummary(summary);
+        return 0;
+    }
+
+    error_code error;
+    if (format.empty()) {
+        if (filesystem::is_directory(input, error)) format = "files";
+        else if (input != "-" && looksLikeCorpus(input)) format = "corpus";
+        else format = "line";
+    }
+    if (format != "files" && format != "corpus" && format != "grid" && format != "line") {
+        cerr << "Unknown format: " << format << endl;
+        return 2;
+    }
+    const bool text = format == "grid" || format == "line";
+    if (text && !shard.isWhole()) {
+        cerr << "--shard needs --format files or corpus" << endl;
+        return 2;
+    }
+    if (format == "corpus" && output.empty()) {
+        cerr << "--format corpus needs --output" << endl;
+        return 2;
+    }
+    if (format == "files" && !filesystem::is_directory(input, error)) {
+        cerr << "No such puzzle folder: " << input << endl;
+        return 1;
+    }
+
+    LogRedirect log_redirect;
+    unique_ptr<MetricsExporter> exporter = metrics.start();
+    SolveJobStatus status;
+    if (format == "files") {
+        if (count < 0) {
+            count = 0;
+            for (const filesystem::directory_entry& entry : filesystem::directory_iterator(input, error)) {
+                count += entry.is_regular_file();
+            }
+        }
+        output = asFolder(output.empty() ? DEFAULT_SOLUTION_FOLDER : output);
+        if (shard.isWhole()) filesystem::create_directories(output, error);  // A shard creates its own segment
+        status = solveAndSaveNPuzzles(count, input, output, prefix, workers, node_budget, validation, shard, engine, cache_capacity);
+    } else if (format == "corpus") {
+        status = solveAndSaveCorpus(input, output, workers, node_budget, validation, shard, engine, cache_capacity);
+    } else {
+        if (output.empty()) output = "-";
+        // The sink writes to stdio's stdout; send cout's log lines to stderr so they stay out of the solutions
+        if (output == "-") log_redirect.saved = cout.rdbuf(cerr.rdbuf());
+        status = solveAndSaveStream(input, output, format == "grid" ? TextLayout::GRID : TextLayout::LINE,
+                                    count < 0 ? 0 : count, workers, node_budget, validation, engine, cache_capacity);
+    }
+    if (exporter) {
+        exporter.reset();  // Writes the final totals
+        printStageSummary(collectMetrics(), cout);
+    }
+    return exitCode(status);
+}
+
+int runBenchCommand(const vector<string>& args, const string& program) {
+    BenchmarkConfig config;
+    ReportFormat format = ReportFormat::TEXT;
+    string output;
+
+    Flags flags{args};
+    while (flags.next()) {
+        const string& arg = flags.arg;
+        if (arg == "--engines") {
+            config.solvers.clear();
+            for (const string& name : splitList(flags.value())) {
+                SolverType solver;
+                if (!parseEngine(name, solver)) return 2;
+                config.solvers.push_back(solver);
+            }
+        } else if (arg == "--corpora") {
+            config.corpora = splitList(flags.value());
+        } else if (arg == "--size") {
+            config.corpus_size = static_cast<int>(flags.integer(1));
+        } else if (arg == "--warmup") {
+            config.warmup = static_cast<int>(flags.integer(0));
+        } else if (arg == "--seed") {
+            config.seed = flags.count();
+        } else if (arg == "--cpu") {
+            config.cpu = static_cast<int>(flags.integer(0));
+        } else if (arg == "--format") {
+            const string name = flags.value();
+            if (!parseReportFormat(name, format)) {
+                cerr << "Unknown format: " << name << endl;
+                return 2;
+            }
+        } else if (arg == "--output") {
+            output = flags.value();
+        } else if (arg == "--include-slow") {
+            config.include_slow = true;
+        } else if (arg == "--no-batch") {
+            config.include_batch = false;
+        } else if (arg == "--no-stats") {
+            config.collect_stats = false;
+        } else if (arg == "--help" || arg == "-h") {
+            printBenchUsage(program);
+            return 0;
+        } else {
+            cerr << "Unknown option: " << arg << endl;
+            printBenchUsage(program);
+            return 2;
+        }
+    }
+
+    vector<BenchmarkResult> results = runBenchmark(config);
+
+    if (output.empty()) {
+        writeBenchmarkReport(results, config, format, cout);
+    } else {
+        ofstream file(output);
+        if (!file) {
+            cerr << "Unable to write report: " << output << endl;
+            return 1;
+        }
+        writeBenchmarkReport(results, config, format, file);
+    }
+
+    for (const BenchmarkResult& result : results) {
+        if (result.failures > 0) return 1;
+    }
+    return 0;
+}
+
+int runServeCommand(const vector<string>& args, const string& program) {
+    ServiceConfig config;
+    string socket_address, metrics_socket;
+    bool quiet = false;
+    MetricsFlags metrics;
+
+    Flags flags{args};
+    while (flags.next()) {
+        const string& arg = flags.arg;
+        if (arg == "--socket") {
+            socket_address = flags.value();
+        } else if (arg == "--workers") {
+            config.num_workers = static_cast<int>(flags.integer(0));
+        } else if (arg == "--engine") {
+            if (!parseEngine(flags.value(), config.fallback)) return 2;
+        } else if (arg == "--node-budget") {
+            config.node_budget = flags.count();
+        } else if (arg == "--cache") {
+            config.cache_capacity = flags.count();
+        } else if (arg == "--chunk" || arg == "--batch") {
+            config.chunk_size = static_cast<int>(flags.integer(1));
+        } else if (arg == "--quiet") {
+            quiet = true;
+        } else if (arg == "--metrics-socket") {
+            metrics_socket = flags.value();
+        } else if (metrics.parse(flags)) {
+        } else if (arg == "--help" || arg == "-h") {
+            printServeUsage(program);
+            return 0;
+        } else {
+            cerr << "Unknown option: " << arg << endl;
+            printServeUsage(program);
+            return 2;
+        }
+    }
+
+    unique_ptr<MetricsExporter> exporter = metrics.start();
+    MetricsEndpoint endpoint;
+    if (!metrics_socket.empty()) {
+        setMetricsEnabled(true);
+        if (!endpoint.open(metrics_socket)) return 1;
+    }
+    if (!socket_address.empty()) return runSocketService(socket_address, config) ? 0 : 1;
+
+    // Let cin buffer ahead, so the service can tell a burst of input from a pause
+    ios::sync_with_stdio(false);
+    // The writer thread owns cout; a tied cin would flush it from the reading thread mid-line
+    cin.tie(nullptr);
+    SolverService service(config);
+    ServiceSummary summary = service.serve(cin, cout);
+    if (!quiet) printServiceSummary(summary, cerr);
+    return 0;
+}
+
+int runCompareCommand(const vector<string>& args) {
+    int size = 0;
+    int blanks = DEFAULT_GENERATE_BLANKS;
+
+    Flags flags{args};
+    while (flags.next()) {
+        const string& arg = flags.arg;
+        if (arg == "--size") {
+            size = static_cast<int>(flags.integer(1));
+        } else if (arg == "--blanks") {
+            blanks = static_cast<int>(flags.integer(1));
+            if (blanks > 81) flags.invalid(to_string(blanks));
+        } else if (arg == "--help" || arg == "-h") {
+            printCompareUsage();
+            return 0;
+        } else {
+            return unknownOption(arg, printCompareUsage);
+        }
+    }
+
+    srand(static_cast<unsigned int>(time(0)));
+    if (size > 0) {
+        compareSudokuSolvers(size, blanks);
+        return 0;
+    }
+    compareSudokuSolvers(10, 64);
+    compareSudokuSolvers(100, 45);
+    compareSudokuSolvers(1000, 32);
+    compareSudokuSolvers(10000, 16);
+    return 0;
+}
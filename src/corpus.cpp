@@ -0,0 +1,194 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/corpus.h"
+#include <iostream>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+void packBoard(const Board& board, uint8_t* record) {
+    for (int i = 0; i < CORPUS_RECORD_SIZE; i++) {
+        uint8_t low = board.cells[2 * i];
+        uint8_t high = (2 * i + 1 < 81) ? board.cells[2 * i + 1] : 0;
+        record[i] = static_cast<uint8_t>(low | (high << 4));
+    }
+}
+
+bool unpackBoard(const uint8_t* record, Board& board) {
+    bool valid = true;
+    for (int i = 0; i < CORPUS_RECORD_SIZE; i++) {
+        uint8_t low = record[i] & 0x0F;
+        uint8_t high = record[i] >> 4;
+        board.cells[2 * i] = low;
+        if (2 * i + 1 < 81) board.cells[2 * i + 1] = high;
+        valid = valid && low <= 9 && high <= 9;
+    }
+    return valid;
+}
+
+// ========================= CorpusReader ==========================
+
+CorpusReader::~CorpusReader() {
+    close();
+}
+
+bool CorpusReader::open(const string& path) {
+    close();
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        cerr << "Unable to open corpus: " << path << endl;
+        return false;
+    }
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(CorpusHeader))) {
+        ::close(fd);
+        cerr << "Malformed corpus (too short): " << path << endl;
+        return false;
+    }
+    length = static_cast<size_t>(info.st_size);
+    void* view = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // The mapping stays valid after the descriptor is closed
+    if (view == MAP_FAILED) {
+        cerr << "Unable to map corpus: " << path << endl;
+        length = 0;
+        return false;
+    }
+    madvise(view, length, MADV_SEQUENTIAL);
+    data = static_cast<const uint8_t*>(view);
+    mapped = true;
+#else
+    // No mmap here: load the whole file into one buffer instead
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        cerr << "Unable to open corpus: " << path << endl;
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    length = static_cast<size_t>(ftell(file));
+    fseek(file, 0, SEEK_SET);
+    uint8_t* buffer = new uint8_t[length > 0 ? length : 1];
+    size_t got = fread(buffer, 1, length, file);
+    fclose(file);
+    data = buffer;
+    mapped = false;
+    if (got != length || length < sizeof(CorpusHeader)) {
+        close();
+        cerr << "Malformed corpus (too short): " << path << endl;
+        return false;
+    }
+#endif
+    memcpy(&head, data, sizeof(CorpusHeader));
+    uint64_t capacity = (length - sizeof(CorpusHeader)) / CORPUS_RECORD_SIZE;
+    if (head.magic != CORPUS_MAGIC || head.version != CORPUS_VERSION ||
+        head.record_size != CORPUS_RECORD_SIZE || head.count > capacity) {
+        close();
+        cerr << "Malformed corpus header: " << path << endl;
+        return false;
+    }
+    return true;
+}
+
+void CorpusReader::close() {
+    if (data != nullptr) {
+#ifndef _WIN32
+        if (mapped) munmap(const_cast<uint8_t*>(data), length);
+        else delete[] data;
+#else
+        delete[] data;
+#endif
+    }
+    data = nullptr;
+    length = 0;
+    mapped = false;
+    head = CorpusHeader{};
+}
+
+bool CorpusReader::read(const uint64_t& index, Board& board) const {
+    if (data == nullptr || index >= head.count) return false;
+    return unpackBoard(data + sizeof(CorpusHeader) + index * CORPUS_RECORD_SIZE, board);
+}
+
+// ========================= CorpusWriter ==========================
+
+CorpusWriter::~CorpusWriter() {
+    close();
+}
+
+bool CorpusWriter::open(const string& path, const CorpusHeader& params) {
+    close();
+    file = fopen(path.c_str(), "r+b");
+    if (file != nullptr) {
+        CorpusHeader existing;
+        if (fread(&existing, sizeof(existing), 1, file) == 1 && existing.magic == CORPUS_MAGIC &&
+            existing.version == CORPUS_VERSION && existing.record_size == CORPUS_RECORD_SIZE) {
+            head = existing;
+            base = existing.count;
+            return true;
+        }
+        // Not a corpus: start over
+        fclose(file);
+        file = nullptr;
+    }
+    file = fopen(path.c_str(), "w+b");
+    if (file == nullptr) {
+        cerr << "Unable to create corpus: " << path << endl;
+        return false;
+    }
+    head = params;
+    head.magic = CORPUS_MAGIC;
+    head.version = CORPUS_VERSION;
+    head.record_size = CORPUS_RECORD_SIZE;
+    head.count = 0;
+    base = 0;
+    return fwrite(&head, sizeof(head), 1, file) == 1;
+}
+
+bool CorpusWriter::writeRecordAt(const uint64_t& position, const Board& board) {
+    uint8_t record[CORPUS_RECORD_SIZE];
+    packBoard(board, record);
+    long offset = static_cast<long>(sizeof(CorpusHeader) + position * CORPUS_RECORD_SIZE);
+    if (fseek(file, offset, SEEK_SET) != 0) return false;
+    if (fwrite(record, CORPUS_RECORD_SIZE, 1, file) != 1) return false;
+    if (position + 1 > head.count) head.count = position + 1;
+    return true;
+}
+
+bool CorpusWriter::append(const Board& board) {
+    lock_guard<mutex> guard(lock);
+    if (file == nullptr) return false;
+    return writeRecordAt(head.count, board);
+}
+
+bool CorpusWriter::write(const uint64_t& index, const Board& board) {
+    lock_guard<mutex> guard(lock);
+    if (file == nullptr) return false;
+    return writeRecordAt(base + index, board);
+}
+
+bool CorpusWriter::padTo(const uint64_t& count) {
+    lock_guard<mutex> guard(lock);
+    if (file == nullptr) return false;
+    const Board blank{};
+    while (head.count < base + count) {
+        if (!writeRecordAt(head.count, blank)) return false;
+    }
+    return true;
+}
+
+bool CorpusWriter::close() {
+    lock_guard<mutex> guard(lock);
+    if (file == nullptr) return true;
+    bool ok = fseek(file, 0, SEEK_SET) == 0 && fwrite(&head, sizeof(head), 1, file) == 1;
+    ok = (fclose(file) == 0) && ok;
+    file = nullptr;
+    return ok;
+}
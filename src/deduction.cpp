@@ -0,0 +1,205 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/deduction.h"
+#include "../include/bitops.h"
+#include "../include/cell_selection.h"
+
+namespace {
+    // Result of one pass over the board
+    const int CONTRADICTION = -1;
+
+    struct DeductionState {
+        Board& board;
+        uint16_t cand[81];
+        int open = 0;           // Empty cells left
+        uint8_t singles[82];    // Open cells that dropped to one candidate, not yet placed (+1 for the branch-free push)
+        int pending = 0;
+
+        explicit DeductionState(Board& target) : board(target) {}
+
+        // Places `digit` at `cell` and strikes it from the peers; false on an emptied peer
+        bool place(const int& cell, const int& digit) {
+            uint16_t bit = 1u << (digit - 1);
+            board.cells[cell] = static_cast<uint8_t>(digit);
+            cand[cell] = bit;
+            open--;
+            bool emptied = false;
+            for (int i = 0; i < 20; i++) {
+                // Branch-free: which peers held the digit is unpredictable
+                int peer = PEER_TABLE.peers[cell][i];
+                uint16_t before = cand[peer];
+                uint16_t after = before & ~bit;
+                cand[peer] = after;
+                emptied |= after == 0;
+                singles[pending] = static_cast<uint8_t>(peer);
+                pending += (before != after) & ((after & (after - 1)) == 0) & (board.cells[peer] == 0);
+            }
+            return !emptied;
+        }
+
+        bool init() {
+            uint16_t rows[9] = {0}, cols[9] = {0}, boxes[9] = {0};
+            open = 0;
+            pending = 0;
+            for (int cell = 0; cell < 81; cell++) {
+                int digit = board.cells[cell];
+                if (digit == 0) { open++; continue; }
+                if (digit > 9) return false;
+                uint16_t bit = 1u << (digit - 1);
+                uint16_t& row = rows[PEER_TABLE.row[cell]];
+                uint16_t& col = cols[PEER_TABLE.col[cell]];
+                uint16_t& box = boxes[PEER_TABLE.box[cell]];
+                if ((row | col | box) & bit) return false;  // Two givens clash
+                row |= bit;
+                col |= bit;
+                box |= bit;
+                cand[cell] = bit;
+            }
+            for (int cell = 0; cell < 81; cell++) {
+                if (board.cells[cell] != 0) continue;
+                cand[cell] = ALL_DIGITS & ~(rows[PEER_TABLE.row[cell]] | cols[PEER_TABLE.col[cell]] | boxes[PEER_TABLE.box[cell]]);
+                if (cand[cell] == 0) return false;
+                if (!(cand[cell] & (cand[cell] - 1))) singles[pending++] = static_cast<uint8_t>(cell);
+            }
+            return true;
+        }
+
+        // Drains the queue of cells that place() reduced to a single candidate
+        int nakedSingles() {
+            int placed = 0;
+            while (pending > 0) {
+                int cell = singles[--pending];
+                if (board.cells[cell] != 0) continue;  // Queued twice
+                if (!place(cell, bitToDigit(cand[cell]))) return CONTRADICTION;
+                placed++;
+            }
+            return placed;
+        }
+
+        int hiddenSingles() {
+            int placed = 0;
+            for (int u = 0; u < 27; u++) {
+                const uint8_t* unit = UNIT_TABLE.cells[u];
+                uint16_t once = 0, twice = 0;
+                for (int k = 0; k < 9; k++) {
+                    twice |= once & cand[unit[k]];
+                    once |= cand[unit[k]];
+                }
+                if (once != ALL_DIGITS) return CONTRADICTION;  // Some digit has no place in the unit
+                uint16_t exactly = once & ~twice;
+                for (int k = 0; k < 9 && exactly; k++) {
+                    int cell = unit[k];
+                    uint16_t hidden = cand[cell] & exactly;
+                    if (board.cells[cell] != 0 || hidden == 0) continue;
+                    if (hidden & (hidden - 1)) return CONTRADICTION;  // Two digits need this cell
+                    if (!place(cell, bitToDigit(hidden))) return CONTRADICTION;
+                    exactly &= ~hidden;
+                    placed++;
+                }
+            }
+            return placed;
+        }
+
+        // Removes `bit` from the open cells of `unit` that are not in `keep`; returns the count removed
+        int eliminate(const int& unit, const int& keep, const uint16_t& bit) {
+            int removed = 0;
+            for (int k = 0; k < 9; k++) {
+                int cell = UNIT_TABLE.cells[unit][k];
+                if (board.cells[cell] != 0 || !(cand[cell] & bit) || unitOf(cell, keep)) continue;
+                cand[cell] &= ~bit;
+                if (cand[cell] == 0) return CONTRADICTION;
+                if (!(cand[cell] & (cand[cell] - 1))) singles[pending++] = static_cast<uint8_t>(cell);
+                removed++;
+            }
+            return removed;
+        }
+
+        static bool unitOf(const int& cell, const int& unit) {
+            const uint8_t* units = UNIT_TABLE.of[cell];
+            return (units[0] == unit) | (units[1] == unit) | (units[2] == unit);
+        }
+
+        int lockedCandidates() {
+            int removed = 0;
+            for (int digit = 1; digit <= 9; digit++) {
+                uint16_t bit = 1u << (digit - 1);
+                for (int u = 0; u < 27; u++) {
+                    // Collect the rows, columns and boxes holding this digit's open candidates
+                    int rows = 0, cols = 0, boxes = 0, found = 0;
+                    for (int k = 0; k < 9; k++) {
+                        int cell = UNIT_TABLE.cells[u][k];
+                        if (board.cells[cell] != 0 || !(cand[cell] & bit)) continue;
+                        rows |= 1 << PEER_TABLE.row[cell];
+                        cols |= 1 << PEER_TABLE.col[cell];
+                        boxes |= 1 << PEER_TABLE.box[cell];
+                        found++;
+                    }
+                    if (found < 2) continue;  // Singles are handled by the cheaper passes
+
+                    int n = 0;
+                    if (u >= 18) {
+                        // Pointing: the box's candidates lie on one row or column
+                        if (countBits(rows) == 1) n = eliminate(lowestBit(rows), u, bit);
+                        else if (countBits(cols) == 1) n = eliminate(9 + lowestBit(cols), u, bit);
+                    } else if (countBits(boxes) == 1) {
+                        // Claiming: the line's candidates lie in one box
+                        n = eliminate(18 + lowestBit(boxes), u, bit);
+                    }
+                    if (n == CONTRADICTION) return CONTRADICTION;
+                    removed += n;
+                }
+            }
+            return removed;
+        }
+    };
+}
+
+const char* difficultyName(const Difficulty& difficulty) {
+    switch (difficulty) {
+        case Difficulty::EASY: return "easy";
+        case Difficulty::MEDIUM: return "medium";
+        case Difficulty::HARD: return "hard";
+        case Difficulty::EXPERT: return "expert";
+        case Difficulty::INVALID: return "invalid";
+    }
+    return "unknown";
+}
+
+bool deduce(Board& board, DeductionReport& report) {
+    report = DeductionReport{};
+    DeductionState state(board);
+    bool ok = state.init();
+
+    while (ok && state.open > 0) {
+        int n = state.nakedSingles();
+        if (n > 0) { report.naked_singles += n; continue; }
+        if (n == 0) {
+            n = state.hiddenSingles();
+            if (n > 0) { report.hidden_singles += n; continue; }
+        }
+        if (n == 0) {
+            n = state.lockedCandidates();
+            if (n > 0) { report.locked_candidates += n; continue; }
+        }
+        ok = n == 0;
+        break;  // No technique made progress (or one found a contradiction)
+    }
+
+    report.open_cells = 0;
+    for (int cell = 0; cell < 81; cell++) report.open_cells += board.cells[cell] == 0;
+    report.contradiction = !ok;
+    if (!ok) report.difficulty = Difficulty::INVALID;
+    else if (report.open_cells > 0) report.difficulty = Difficulty::EXPERT;
+    else if (report.locked_candidates > 0) report.difficulty = Difficulty::HARD;
+    else if (report.hidden_singles > 0) report.difficulty = Difficulty::MEDIUM;
+    else report.difficulty = Difficulty::EASY;
+    return ok;
+}
+
+Difficulty gradeDifficulty(const Board& board) {
+    Board copy = board;
+    DeductionReport report;
+    deduce(copy, report);
+    return report.difficulty;
+}
@@ -0,0 +1,201 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/dlx.h"
+#include "../include/geometry.h"
+#include "../include/solve_budget.h"
+
+DlxSolver::DlxSolver() {
+    // Column headers form a circular list through the root
+    for (int c = 0; c <= COLUMNS; c++) {
+        left[c] = static_cast<uint16_t>(c == 0 ? COLUMNS : c - 1);
+        right[c] = static_cast<uint16_t>(c == COLUMNS ? 0 : c + 1);
+        up[c] = down[c] = column[c] = static_cast<uint16_t>(c);
+        size[c] = 0;
+        active[c] = true;
+    }
+
+    int node = COLUMNS + 1;
+    for (int row = 0; row < ROWS; row++) {
+        int cell = row / 9, d = row % 9;
+        int r = PEER_TABLE.row[cell], c = PEER_TABLE.col[cell], b = PEER_TABLE.box[cell];
+        // Header indexes are 1-based: 1..81 cell, 82..162 row, 163..243 column, 244..324 box
+        const int HEADERS[4] = { 1 + cell, 82 + r * 9 + d, 163 + c * 9 + d, 244 + b * 9 + d };
+
+        row_start[row] = static_cast<uint16_t>(node);
+        for (int i = 0; i < 4; i++, node++) {
+            int h = HEADERS[i];
+            // Append at the bottom of the column
+            column[node] = static_cast<uint16_t>(h);
+            row_of[node] = static_cast<uint16_t>(row);
+            up[node] = up[h];
+            down[node] = static_cast<uint16_t>(h);
+            down[up[h]] = static_cast<uint16_t>(node);
+            up[h] = static_cast<uint16_t>(node);
+            size[h]++;
+            // Circular row list of four nodes
+            left[node] = static_cast<uint16_t>(i == 0 ? node + 3 : node - 1);
+            right[node] = static_cast<uint16_t>(i == 3 ? node - 3 : node + 1);
+        }
+    }
+}
+
+void DlxSolver::cover(const int& c) {
+    active[c] = false;
+    right[left[c]] = right[c];
+    left[right[c]] = left[c];
+    for (int i = down[c]; i != c; i = down[i]) {
+        for (int j = right[i]; j != i; j = right[j]) {
+            down[up[j]] = down[j];
+            up[down[j]] = up[j];
+            size[column[j]]--;
+        }
+    }
+}
+
+void DlxSolver::uncover(const int& c) {
+    for (int i = up[c]; i != c; i = up[i]) {
+        for (int j = left[i]; j != i; j = left[j]) {
+            size[column[j]]++;
+            down[up[j]] = static_cast<uint16_t>(j);
+            up[down[j]] = static_cast<uint16_t>(j);
+        }
+    }
+    right[left[c]] = static_cast<uint16_t>(c);
+    left[right[c]] = static_cast<uint16_t>(c);
+    active[c] = true;
+}
+
+bool DlxSolver::selectRow(const int& row) {
+    int start = row_start[row];
+    for (int j = start, i = 0; i < 4; j = right[j], i++) {
+        if (!active[column[j]]) return false;  // A given clashes with an earlier one
+    }
+    for (int j = start, i = 0; i < 4; j = right[j], i++) cover(column[j]);
+    return true;
+}
+
+void DlxSolver::deselectRow(const int& row) {
+    int start = row_start[row];
+    for (int j = left[start]; j != start; j = left[j]) uncover(column[j]);
+    uncover(column[start]);
+}
+
+void DlxSolver::unwind() {
+    // Always unwind so the arena is intact for the next puzzle
+    while (depth > 0) {
+        depth--;
+        int i = trail_node[depth];
+        if (i != trail_column[depth]) {
+            for (int j = left[i]; j != i; j = left[j]) uncover(column[j]);
+        }
+        uncover(trail_column[depth]);
+    }
+}
+
+template <typename Recorder>
+bool DlxSolver::search(Board& board, Recorder& recorder) {
+    // Level `depth` has covered trail_column[depth] and is trying the row of node trail_node[depth];
+    // trail_node == trail_column means no row has been tried yet
+    bool descend = true;
+    while (true) {
+        if (descend) {
+            descend = false;
+            if (right[0] == 0) {
+                // Every constraint is covered: write the chosen rows into the board
+                for (int i = 0; i < depth; i++) {
+                    int row = row_of[trail_node[i]];
+                    board.cells[row / 9] = static_cast<uint8_t>(row % 9 + 1);
+                }
+                unwind();
+                return true;
+            }
+
+            // Column with the fewest remaining rows; stop early on 0 (dead end) or 1 (forced)
+            uint64_t start = recorder.clock();
+            int best = right[0];
+            for (int c = right[best]; c != 0 && size[best] > 1; c = right[c]) {
+                if (size[c] < size[best]) best = c;
+            }
+            recorder.addSelection(start);
+            if (size[best] == 0) {
+                if (depth == 0) return false;
+                depth--;
+                continue;
+            }
+
+            cover(best);
+            recorder.propagated(1);
+            trail_column[depth] = static_cast<uint16_t>(best);
+            trail_node[depth] = static_cast<uint16_t>(best);
+        }
+
+        int c = trail_column[depth];
+        int i = trail_node[depth];
+        if (i != c) {
+            // The row tried at this level led to a dead end
+            uint64_t start = recorder.clock();
+            for (int j = left[i]; j != i; j = left[j]) uncover(column[j]);
+            recorder.addPlacement(start);
+            recorder.backtrack();
+        }
+        i = down[i];
+        trail_node[depth] = static_cast<uint16_t>(i);
+        if (i == c) {
+            uncover(c);
+            if (depth == 0) return false;
+            depth--;
+            continue;
+        }
+
+        if (recorder.stop()) {
+            // Budget used up: row i is not covered yet, so this level only holds its column
+            trail_node[depth] = static_cast<uint16_t>(c);
+            depth++;
+            unwind();
+            return false;
+        }
+        recorder.node(depth + 1);
+        uint64_t start = recorder.clock();
+        for (int j = right[i]; j != i; j = right[j]) cover(column[j]);
+        recorder.addPlacement(start);
+        recorder.propagated(3);
+        depth++;
+        descend = true;
+    }
+}
+
+bool DlxSolver::solve(Board& board) {
+    NullRecorder recorder;
+    return solve(board, recorder);
+}
+
+template <typename Recorder>
+bool DlxSolver::solve(Board& board, Recorder& recorder) {
+    int givens[81];
+    int given_count = 0;
+    bool consistent = true;
+    for (int cell = 0; cell < 81 && consistent; cell++) {
+        int value = board.cells[cell];
+        if (value == 0) continue;
+        if (value > 9) {  // No row exists for it; the other engines reject such boards too
+            consistent = false;
+            break;
+        }
+        int row = cell * 9 + value - 1;
+        consistent = selectRow(row);
+        if (consistent) givens[given_count++] = row;
+    }
+
+    depth = 0;
+    bool solved = consistent && search(board, recorder);
+
+    while (given_count > 0) deselectRow(givens[--given_count]);
+    return solved;
+}
+
+template bool DlxSolver::solve<NullRecorder>(Board&, NullRecorder&);
+template bool DlxSolver::solve<CountingRecorder>(Board&, CountingRecorder&);
+template bool DlxSolver::solve<TimingRecorder>(Board&, TimingRecorder&);
+template bool DlxSolver::solve<BudgetRecorder<NullRecorder>>(Board&, BudgetRecorder<NullRecorder>&);
+template bool DlxSolver::solve<BudgetRecorder<CountingRecorder>>(Board&, BudgetRecorder<CountingRecorder>&);
@@ -27,6 +27,10 @@
 #include "../include/generator.h"
 #include "../include/sudoku.h"
 #include "../include/sudoku_io.h"
+#include "../include/board.h"
+#include "../include/bitops.h"
+#include "../include/cell_selection.h"
+#include "../include/board_pool.h"
 #include <ctime>
 #include <random>
 #include <algorithm>
@@ -39,11 +43,8 @@
 using namespace std;
 
 int** getEmptyBoard() {
-    int** board = new int*[9];
-    for(int i = 0; i < 9; i++){
-        board[i] = new int[9] {0, 0, 0, 0, 0, 0, 0, 0, 0};
-    }//Initialization ends here..
-    return board;
+    // One recycled block per board instead of ten allocations; deallocateBoard() hands it back
+    return acquireBoard();
 }
 
 // Hint 1:  Implement a function to return shuffled vectors
@@ -63,10 +64,26 @@ std::vector<int> getShuffledVector() {
     // Dummy implementation:
     // Temporary static return for testing
     // return {3, 1, 4, 2, 7, 6, 5, 9, 8};
+    return getShuffledVector(getThreadEngine());
+}
+
+RandomEngine& getThreadEngine() {
+    // Seeded once per thread; std::random_device can be a syscall, so never construct it per call
+    thread_local RandomEngine engine(std::random_device{}());
+    return engine;
+}
+
+uint64_t derivePuzzleSeed(const uint64_t& master_seed, const int& index) {
+    // SplitMix64 finaliser over (master, index): neighbouring indexes get unrelated streams
+    uint64_t z = master_seed + 0x9E3779B97F4A7C15ULL * (static_cast<uint64_t>(index) + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+std::vector<int> getShuffledVector(RandomEngine& engine) {
     std::vector<int> fill_box = {1,2,3,4,5,6,7,8,9};
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::shuffle(fill_box.begin(),fill_box.end(),g);
+    std::shuffle(fill_box.begin(),fill_box.end(),engine);
     return fill_box; //Returning the randomly swapped vector
 }
 
@@ -124,7 +141,11 @@ std::vector<int> getShuffledVector() {
                 +-------+-------+-------+
             */
 
-void fillBoardWithIndependentBox(int** BOARD) {
+void fillBoardWithIndependentBox(Board& BOARD) {
+    fillBoardWithIndependentBox(BOARD, getThreadEngine());
+}
+
+void fillBoardWithIndependentBox(Board& BOARD, RandomEngine& engine) {
     // TODO: Implement logic to fill diagonal 3x3 boxes
     /**
      * TODO:
@@ -158,34 +179,25 @@ void fillBoardWithIndependentBox(int** BOARD) {
 //         }
 //     }
 // }
-    std::vector<int> diagnol1 = getShuffledVector();
-    std::vector<int> diagnol2 = getShuffledVector();
-    std::vector<int> diagnol3 = getShuffledVector();
-    // Iterating over the board three times
-    // For diagnol1
-    for(int rows = 0;rows<3;rows++){
-        for(int cols = 0;cols<3;cols++){
-            BOARD[rows][cols] = diagnol1.back();
-            diagnol1.pop_back();
-        }
-    }
-     // For diagnol2
-     for(int rows = 3;rows<6;rows++){
-        for(int cols = 3;cols<6;cols++){
-            BOARD[rows][cols] = diagnol2.back();
-            diagnol2.pop_back();
-        }
-    }
-      // For diagnol3
-      for(int rows = 6;rows<9;rows++){
-        for(int cols = 6;cols<9;cols++){
-            BOARD[rows][cols] = diagnol3.back();
-            diagnol3.pop_back();
+    // Same shuffles as getShuffledVector(), on the stack so generating a grid does not allocate
+    for(int box = 0; box < 3; box++){
+        int digits[9] = {1,2,3,4,5,6,7,8,9};
+        std::shuffle(digits, digits + 9, engine);
+        int next = 8;  // Taken from the back, like popping the vector
+        // Diagonal boxes are units 18, 22 and 26; their cells are listed row-major
+        for(const uint8_t& cell : UNIT_TABLE.cells[18 + box * 4]){
+            BOARD.cells[cell] = static_cast<uint8_t>(digits[next--]);
         }
     }
 }
 // This code is final and good for production
 
+void fillBoardWithIndependentBox(int** BOARD) {
+    Board board = toBoard(BOARD);
+    fillBoardWithIndependentBox(board);
+    copyToBoard(board, BOARD);
+}
+
 
 // Hint 3:  SolveBoard by using function provided in sudoku.h
             /* Example Solve Board
@@ -230,7 +242,7 @@ void fillBoardWithIndependentBox(int** BOARD) {
              */
 
 // Function to randomly delete 'n' items from a 9x9 Sudoku board using bitsets
-void deleteRandomItems(int** BOARD, const int& n) {
+void deleteRandomItems(Board& BOARD, const int& n) {
     // TODO: Implement logic to delete 'n' random cells from the board
     /**
      * TODO:
@@ -246,31 +258,149 @@ void deleteRandomItems(int** BOARD, const int& n) {
      * @param BOARD A 9x9 Sudoku board.
      * @param n The number of cells to delete (should be between 1 and 81).
      */
-        if (BOARD == nullptr || n < 1 || n > 81) {
+        if (n < 1 || n > 81) {
             cout << "Invalid number of cells to delete" << endl;
             exit(1);
             //If the number of cells to be deleted isn't between 1-81, immediatley kill the program
         }
-        int rows = 8;
-        int columns = 8;
-        int count = 1;
-        // Dummy implementation: Set the first 3 rows to 0
-        while (count<=n){
-            int row_cell = rand()%(rows+1);
-            int col_cell = rand()%(columns+1);
-            if(BOARD[row_cell][col_cell]!=0){
-                BOARD[row_cell][col_cell] = 0;
-                count++;
+        // rand() only seeds the engine, so srand() still makes the deletions reproducible
+        RandomEngine engine(static_cast<uint64_t>(rand()));
+        deleteRandomItems(BOARD, n, engine);
+    }
+
+int selectRandomCells(const Board& BOARD, const int& n, int* cells, RandomEngine& engine) {
+    int filled = 0;
+    for (int cell = 0; cell < 81; cell++) {
+        if (BOARD.cells[cell] != 0) cells[filled++] = cell;
+    }
+    int picks = n < filled ? n : filled;
+    // Partial Fisher-Yates: position i takes a random cell from the not yet picked tail
+    for (int i = 0; i < picks; i++) {
+        std::uniform_int_distribution<int> pick(i, filled - 1);
+        std::swap(cells[i], cells[pick(engine)]);
+    }
+    return picks;
+}
+
+void deleteRandomItems(Board& BOARD, const int& n, RandomEngine& engine) {
+        if (n < 1 || n > 81) {
+            cout << "Invalid number of cells to delete" << endl;
+            exit(1);
+        }
+        int cells[81];
+        int picks = selectRandomCells(BOARD, n, cells, engine);
+        for (int i = 0; i < picks; i++) BOARD.cells[cells[i]] = 0;
+    }
+
+int deleteItemsKeepingUnique(Board& BOARD, const int& n, RandomEngine& engine) {
+    if (n < 1 || n > 81) {
+        cout << "Invalid number of cells to delete" << endl;
+        exit(1);
+    }
+    int order[81];
+    int filled = selectRandomCells(BOARD, 81, order, engine);
+
+    // Blank cells one at a time; keep a removal only if the puzzle still has a single solution
+    int removed = 0;
+    for (int i = 0; i < filled && removed < n; i++) {
+        int cell = order[i];
+        uint8_t value = BOARD.cells[cell];
+        BOARD.cells[cell] = 0;
+        if (hasUniqueSolution(BOARD)) removed++;
+        else BOARD.cells[cell] = value;
+    }
+    return removed;
+}
+
+void deleteRandomItems(int** BOARD, const int& n) {
+    if (BOARD == nullptr) {
+        cout << "Invalid number of cells to delete" << endl;
+        exit(1);
+    }
+    Board board = toBoard(BOARD);
+    deleteRandomItems(board, n);
+    copyToBoard(board, BOARD);
+}
+
+
+
+namespace {
+    // Usage masks of the grid being filled (bit (k - 1) set = digit k used)
+    struct GridFill {
+        uint16_t rows[9];
+        uint16_t cols[9];
+        uint16_t boxes[9];
+    };
+
+    bool fillRandomly(Board& BOARD, GridFill& fill, RandomEngine& engine) {
+        // Most constrained open cell first
+        int best = -1, best_count = 10;
+        uint16_t best_mask = 0;
+        for (int cell = 0; cell < 81 && best_count > 1; cell++) {
+            if (BOARD.cells[cell] != 0) continue;
+            uint16_t mask = ALL_DIGITS & ~(fill.rows[PEER_TABLE.row[cell]] | fill.cols[PEER_TABLE.col[cell]] |
+                                           fill.boxes[PEER_TABLE.box[cell]]);
+            int count = countBits(mask);
+            if (count < best_count) {
+                best = cell;
+                best_count = count;
+                best_mask = mask;
             }
         }
+        if (best < 0) return true;  // Grid complete
+
+        int digits[9];
+        int n = 0;
+        for (uint16_t options = best_mask; options; options &= options - 1) digits[n++] = bitToDigit(options);
+        std::shuffle(digits, digits + n, engine);
+
+        uint16_t& row = fill.rows[PEER_TABLE.row[best]];
+        uint16_t& col = fill.cols[PEER_TABLE.col[best]];
+        uint16_t& box = fill.boxes[PEER_TABLE.box[best]];
+        for (int i = 0; i < n; i++) {
+            uint16_t bit = 1u << (digits[i] - 1);
+            BOARD.cells[best] = static_cast<uint8_t>(digits[i]);
+            row |= bit; col |= bit; box |= bit;
+            if (fillRandomly(BOARD, fill, engine)) return true;
+            row &= ~bit; col &= ~bit; box &= ~bit;
+        }
+        BOARD.cells[best] = 0;
+        return false;
     }
+}
 
+void generateSolvedGrid(Board& BOARD, RandomEngine& engine) {
+    BOARD = Board{};
+    fillBoardWithIndependentBox(BOARD, engine);
+    GridFill fill{};
+    for (int cell = 0; cell < 81; cell++) {
+        if (BOARD.cells[cell] == 0) continue;
+        uint16_t bit = 1u << (BOARD.cells[cell] - 1);
+        fill.rows[PEER_TABLE.row[cell]] |= bit;
+        fill.cols[PEER_TABLE.col[cell]] |= bit;
+        fill.boxes[PEER_TABLE.box[cell]] |= bit;
+    }
+    // Independent diagonal boxes can always be completed, so this cannot fail
+    fillRandomly(BOARD, fill, engine);
+}
+
+void generateSolvedGrid(Board& BOARD) {
+    generateSolvedGrid(BOARD, getThreadEngine());
+}
 
 
 // Finally return the board
 // Note you need add these function prototypes in generator.h files as well
 
-int** generateBoard(const int& empty_boxes){
+void generateBoard(Board& BOARD, const int& empty_boxes, const GenerationMode& mode){
+    if (mode == GenerationMode::UNIQUE) {
+        generateBoard(BOARD, empty_boxes, getThreadEngine(), mode);
+        return;
+    }
+    generateRandomBoard(BOARD, empty_boxes);
+}
+
+void generateRandomBoard(Board& BOARD, const int& empty_boxes){
     /**
      * @brief Generates a solvable Sudoku board with a specified number of empty cells.
      *
@@ -289,16 +419,20 @@ int** generateBoard(const int& empty_boxes){
      * @return int** A dynamically allocated 9x9 Sudoku board with 'empty_boxes' empty cells.
      */
 
-    // Dummy implementation: Returning static sudoku board
-    int** BOARD = new int*[9];
-    BOARD = getEmptyBoard();
-    fillBoardWithIndependentBox(BOARD);
-    if(solveBoard(BOARD, 0,0)){
-        cout<<"Board is solved"<<endl; //Easy for debugging
-    }
-    else{
-        cout<<"Couldn't solve the board"<<endl;
-    }
+    // The grid engine is seeded from rand() too, so srand() fixes the whole puzzle, not just its blanks
+    RandomEngine engine(static_cast<uint64_t>(rand()));
+    generateSolvedGrid(BOARD, engine);
     deleteRandomItems(BOARD,empty_boxes);
-    return BOARD;
+}
+
+void generateBoard(Board& BOARD, const int& empty_boxes, RandomEngine& engine, const GenerationMode& mode){
+    generateSolvedGrid(BOARD, engine);
+    if (mode == GenerationMode::UNIQUE) deleteItemsKeepingUnique(BOARD, empty_boxes, engine);
+    else deleteRandomItems(BOARD, empty_boxes, engine);
+}
+
+int** generateBoard(const int& empty_boxes, const GenerationMode& mode){
+    Board board;
+    generateBoard(board, empty_boxes, mode);
+    return toIntBoard(board);
 }
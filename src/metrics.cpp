@@ -0,0 +1,273 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/metrics.h"
+#include "../include/progress.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+using namespace std;
+using namespace std::chrono;
+
+namespace {
+    atomic<bool> METRICS_ENABLED{false};
+
+    // One stage of one thread. Only the owning thread writes, so relaxed load + store is enough to
+    // count; collectMetrics() may read a sample half-recorded, which the next snapshot completes.
+    struct LiveHistogram {
+        atomic<uint64_t> counts[HistogramSnapshot::BUCKETS];
+        atomic<uint64_t> count;
+        atomic<uint64_t> sum_ns;
+        atomic<uint64_t> max_ns;
+
+        LiveHistogram() {
+            for (atomic<uint64_t>& bucket : counts) bucket.store(0, memory_order_relaxed);
+            count.store(0, memory_order_relaxed);
+            sum_ns.store(0, memory_order_relaxed);
+            max_ns.store(0, memory_order_relaxed);
+        }
+
+        static void bump(atomic<uint64_t>& counter, const uint64_t& by) {
+            counter.store(counter.load(memory_order_relaxed) + by, memory_order_relaxed);
+        }
+
+        void record(const uint64_t& nanoseconds, const uint64_t& items) {
+            const uint64_t each = nanoseconds / items;
+            bump(counts[HistogramSnapshot::bucketOf(each)], items);
+            bump(count, items);
+            bump(sum_ns, nanoseconds);
+            if (each > max_ns.load(memory_order_relaxed)) max_ns.store(each, memory_order_relaxed);
+        }
+
+        void addTo(HistogramSnapshot& snapshot) const {
+            for (int b = 0; b < HistogramSnapshot::BUCKETS; b++) snapshot.counts[b] += counts[b].load(memory_order_relaxed);
+            snapshot.count += count.load(memory_order_relaxed);
+            snapshot.sum_ns += sum_ns.load(memory_order_relaxed);
+            const uint64_t most = max_ns.load(memory_order_relaxed);
+            if (most > snapshot.max_ns) snapshot.max_ns = most;
+        }
+    };
+
+    struct ThreadHistograms {
+        LiveHistogram stages[STAGE_COUNT];
+    };
+
+    // Histograms outlive their threads, so samples of a finished pool stay in the totals
+    struct Registry {
+        mutex lock;
+        vector<unique_ptr<ThreadHistograms>> threads;
+        steady_clock::time_point start = steady_clock::now();
+    };
+
+    Registry& registry() {
+        static Registry* instance = new Registry();  // Never destroyed: exporters may run during exit
+        return *instance;
+    }
+
+    ThreadHistograms& localHistograms() {
+        static thread_local ThreadHistograms* local = nullptr;
+        if (local == nullptr) {
+            Registry& shared = registry();
+            lock_guard<mutex> guard(shared.lock);
+            shared.threads.emplace_back(new ThreadHistograms());
+            local = shared.threads.back().get();
+        }
+        return *local;
+    }
+
+    string asSeconds(const uint64_t& nanoseconds) {
+        ostringstream text;
+        text << setprecision(9) << nanoseconds / 1e9;
+        return text.str();
+    }
+
+    string asMicros(const uint64_t& nanoseconds) {
+        ostringstream text;
+        text << fixed << setprecision(1) << nanoseconds / 1e3 << " us";
+        return text.str();
+    }
+
+    // Prometheus bucket bounds: 2^10 ns (about 1 us) to 2^34 ns (about 17 s)
+    const int FIRST_BOUND = 10;
+    const int LAST_BOUND = 34;
+    const double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+}
+
+const char* stageName(const Stage& stage) {
+    switch (stage) {
+        case Stage::PARSE: return "parse";
+        case Stage::GENERATE: return "generate";
+        case Stage::SOLVE: return "solve";
+        case Stage::VALIDATE: return "validate";
+        case Stage::WRITE: return "write";
+    }
+    return "unknown";
+}
+
+void setMetricsEnabled(const bool& enabled) {
+    registry();  // Starts the uptime clock
+    METRICS_ENABLED = enabled;
+}
+
+bool metricsEnabled() {
+    return METRICS_ENABLED.load(memory_order_relaxed);
+}
+
+void recordStage(const Stage& stage, const uint64_t& nanoseconds, const uint64_t& items) {
+    if (items == 0) return;
+    localHistograms().stages[static_cast<int>(stage)].record(nanoseconds, items);
+}
+
+int HistogramSnapshot::bucketOf(const uint64_t& nanoseconds) {
+    if (nanoseconds < SUB_BUCKETS) return static_cast<int>(nanoseconds);
+    int exponent = 63;
+    while (!(nanoseconds >> exponent)) exponent--;
+    if (exponent > MAX_EXPONENT) return BUCKETS - 1;
+    // The top five bits pick the sub-bucket: 16..31 within each power of two
+    return (exponent - 4) * SUB_BUCKETS + static_cast<int>(nanoseconds >> (exponent - 4));
+}
+
+uint64_t HistogramSnapshot::bucketLow(const int& bucket) {
+    if (bucket < SUB_BUCKETS) return static_cast<uint64_t>(bucket);
+    const int exponent = bucket / SUB_BUCKETS + 3;
+    return static_cast<uint64_t>(bucket % SUB_BUCKETS + SUB_BUCKETS) << (exponent - 4);
+}
+
+uint64_t HistogramSnapshot::bucketHigh(const int& bucket) {
+    if (bucket < SUB_BUCKETS) return static_cast<uint64_t>(bucket);
+    const int exponent = bucket / SUB_BUCKETS + 3;
+    return bucketLow(bucket) + (uint64_t(1) << (exponent - 4)) - 1;
+}
+
+void HistogramSnapshot::add(const HistogramSnapshot& other) {
+    for (int b = 0; b < BUCKETS; b++) counts[b] += other.counts[b];
+    count += other.count;
+    sum_ns += other.sum_ns;
+    if (other.max_ns > max_ns) max_ns = other.max_ns;
+}
+
+uint64_t HistogramSnapshot::percentile(const double& q) const {
+    if (count == 0) return 0;
+    // Rank of the quantile sample, counting from 1
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(count) + 0.999999999);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+    uint64_t seen = 0;
+    for (int b = 0; b < BUCKETS; b++) {
+        seen += counts[b];
+        if (seen >= rank) return b == BUCKETS - 1 ? max_ns : min(bucketHigh(b), max_ns);
+    }
+    return max_ns;
+}
+
+uint64_t HistogramSnapshot::countAtOrBelow(const uint64_t& nanoseconds) const {
+    uint64_t total = 0;
+    for (int b = 0; b < BUCKETS && bucketHigh(b) <= nanoseconds; b++) total += counts[b];
+    return total;
+}
+
+MetricsSnapshot collectMetrics() {
+    MetricsSnapshot snapshot;
+    Registry& shared = registry();
+    {
+        lock_guard<mutex> guard(shared.lock);
+        for (const unique_ptr<ThreadHistograms>& thread : shared.threads) {
+            for (int s = 0; s < STAGE_COUNT; s++) thread->stages[s].addTo(snapshot.stages[s]);
+        }
+    }
+    snapshot.jobs = runningJobs();
+    snapshot.uptime_seconds = duration<double>(steady_clock::now() - shared.start).count();
+    return snapshot;
+}
+
+void writePrometheusMetrics(const MetricsSnapshot& snapshot, ostream& out) {
+    ostringstream text;
+    text << "# HELP sudoku_stage_latency_seconds Time spent on one board in each stage.\n"
+         << "# TYPE sudoku_stage_latency_seconds histogram\n";
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        const HistogramSnapshot& histogram = snapshot.stages[s];
+        const string stage = stageName(static_cast<Stage>(s));
+        for (int k = FIRST_BOUND; k <= LAST_BOUND; k++) {
+            const uint64_t bound = uint64_t(1) << k;
+            text << "sudoku_stage_latency_seconds_bucket{stage=\"" << stage << "\",le=\"" << asSeconds(bound) << "\"} "
+                 << histogram.countAtOrBelow(bound - 1) << "\n";
+        }
+        text << "sudoku_stage_latency_seconds_bucket{stage=\"" << stage << "\",le=\"+Inf\"} " << histogram.count << "\n"
+             << "sudoku_stage_latency_seconds_sum{stage=\"" << stage << "\"} " << asSeconds(histogram.sum_ns) << "\n"
+             << "sudoku_stage_latency_seconds_count{stage=\"" << stage << "\"} " << histogram.count << "\n";
+    }
+
+    text << "# HELP sudoku_stage_latency_quantile_seconds Latency quantiles of one board in each stage.\n"
+         << "# TYPE sudoku_stage_latency_quantile_seconds gauge\n";
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        const HistogramSnapshot& histogram = snapshot.stages[s];
+        for (const double& q : QUANTILES) {
+            text << "sudoku_stage_latency_quantile_seconds{stage=\"" << stageName(static_cast<Stage>(s))
+                 << "\",quantile=\"" << q << "\"} " << asSeconds(histogram.percentile(q)) << "\n";
+        }
+    }
+
+    text << "# HELP sudoku_job_total Items a running job expects.\n# TYPE sudoku_job_total gauge\n";
+    for (const JobProgress& job : snapshot.jobs) text << "sudoku_job_total{job=\"" << job.label << "\"} " << job.total << "\n";
+    text << "# HELP sudoku_job_done Items a running job has processed.\n# TYPE sudoku_job_done gauge\n";
+    for (const JobProgress& job : snapshot.jobs) text << "sudoku_job_done{job=\"" << job.label << "\"} " << job.done << "\n";
+    text << "# HELP sudoku_job_succeeded Items a running job has processed successfully.\n# TYPE sudoku_job_succeeded gauge\n";
+    for (const JobProgress& job : snapshot.jobs) text << "sudoku_job_succeeded{job=\"" << job.label << "\"} " << job.succeeded << "\n";
+    text << "# HELP sudoku_job_elapsed_seconds Run time of a running job.\n# TYPE sudoku_job_elapsed_seconds gauge\n";
+    for (const JobProgress& job : snapshot.jobs) {
+        text << "sudoku_job_elapsed_seconds{job=\"" << job.label << "\"} " << job.elapsed_seconds << "\n";
+    }
+
+    text << "# HELP sudoku_uptime_seconds Time since metrics started.\n# TYPE sudoku_uptime_seconds gauge\n"
+         << "sudoku_uptime_seconds " << snapshot.uptime_seconds << "\n";
+    out << text.str();
+}
+
+void printStageSummary(const MetricsSnapshot& snapshot, ostream& out) {
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        const HistogramSnapshot& histogram = snapshot.stages[s];
+        if (histogram.count == 0) continue;
+        out << stageName(static_cast<Stage>(s)) << ": " << histogram.count << " boards, mean "
+            << asMicros(histogram.sum_ns / histogram.count) << ", p50 " << asMicros(histogram.percentile(0.5))
+            << ", p99 " << asMicros(histogram.percentile(0.99)) << ", max " << asMicros(histogram.max_ns) << endl;
+    }
+}
+
+MetricsExporter::MetricsExporter(const string& path, const double& interval_seconds)
+    : path(path), interval(duration_cast<steady_clock::duration>(duration<double>(interval_seconds))) {
+    worker = thread([this]() {
+        unique_lock<mutex> guard(lock);
+        while (!wake.wait_for(guard, interval, [this]() { return stopping; })) {
+            guard.unlock();
+            exportNow();
+            guard.lock();
+        }
+    });
+}
+
+MetricsExporter::~MetricsExporter() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+    exportNow();  // The final totals
+}
+
+bool MetricsExporter::exportNow() {
+    const string staging = path + ".tmp";
+    ofstream out(staging);
+    writePrometheusMetrics(collectMetrics(), out);
+    out.close();
+    if (!out || std::rename(staging.c_str(), path.c_str()) != 0) {
+        cerr << "Unable to write metrics: " << path << endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,80 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/progress.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace std::chrono;
+
+namespace {
+    atomic<bool> QUIET_MODE{false};
+
+    // Live reporters, for runningJobs(); a reporter unlists itself before it is destroyed
+    mutex JOBS_LOCK;
+    vector<const ProgressReporter*> JOBS;
+}
+
+void setQuietMode(const bool& quiet) {
+    QUIET_MODE = quiet;
+}
+
+bool isQuietMode() {
+    return QUIET_MODE.load(memory_order_relaxed);
+}
+
+ProgressReporter::ProgressReporter(const string& label, const int& total, const double& interval_seconds)
+    : label(label), total(total),
+      interval(duration_cast<steady_clock::duration>(duration<double>(interval_seconds))),
+      start(steady_clock::now()) {
+    next_report = (start + interval).time_since_epoch().count();
+    lock_guard<mutex> guard(JOBS_LOCK);
+    JOBS.push_back(this);
+}
+
+ProgressReporter::~ProgressReporter() {
+    lock_guard<mutex> guard(JOBS_LOCK);
+    JOBS.erase(remove(JOBS.begin(), JOBS.end(), this), JOBS.end());
+}
+
+JobProgress ProgressReporter::progress() const {
+    JobProgress job;
+    job.label = label;
+    job.total = total;
+    job.done = completed.load();
+    job.succeeded = successes.load();
+    job.elapsed_seconds = duration<double>(steady_clock::now() - start).count();
+    return job;
+}
+
+vector<JobProgress> runningJobs() {
+    vector<JobProgress> jobs;
+    lock_guard<mutex> guard(JOBS_LOCK);
+    for (const ProgressReporter* reporter : JOBS) jobs.push_back(reporter->progress());
+    return jobs;
+}
+
+void ProgressReporter::tick(const bool& success) {
+    completed++;
+    if (success) successes++;
+    int64_t now = steady_clock::now().time_since_epoch().count();
+    int64_t due = next_report.load(memory_order_relaxed);
+    // Only the thread that wins the exchange prints, everyone else returns immediately
+    if (now >= due && next_report.compare_exchange_strong(due, now + interval.count())) print(false);
+}
+
+void ProgressReporter::finish() {
+    print(true);
+}
+
+void ProgressReporter::print(const bool& final_line) {
+    double elapsed = duration<double>(steady_clock::now() - start).count();
+    int n = completed.load();
+    lock_guard<mutex> guard(print_lock);
+    cout << label << ": " << n << "/" << total << " (" << successes.load() << " ok, "
+         << fixed << setprecision(1) << (elapsed > 0 ? n / elapsed : 0.0) << "/s"
+         << (final_line ? ", done in " : ", ") << setprecision(2) << elapsed << "s)" << endl;
+}
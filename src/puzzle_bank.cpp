@@ -0,0 +1,199 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/puzzle_bank.h"
+#include "../include/corpus.h"
+#include "../include/sudoku.h"
+#include "../include/thread_pool.h"
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+
+using namespace std;
+
+namespace {
+    const Difficulty GRADES[DIFFICULTY_GRADES] = {Difficulty::EASY, Difficulty::MEDIUM, Difficulty::HARD, Difficulty::EXPERT};
+
+    // One pass over a fresh solved grid; true if it ends inside the band
+    bool carveInBand(Board& BOARD, const DifficultyTarget& target, RandomEngine& engine, Difficulty& grade) {
+        generateSolvedGrid(BOARD, engine);
+        int order[81];
+        const int filled = selectRandomCells(BOARD, 81, order, engine);
+        const int max_blanks = target.max_blanks < 81 ? target.max_blanks : 81;
+
+        grade = Difficulty::EASY;
+        int blanks = 0;
+        for (int i = 0; i < filled && blanks < max_blanks; i++) {
+            if (target.contains(grade) && blanks >= target.min_blanks) return true;
+            const int cell = order[i];
+            const uint8_t value = BOARD.cells[cell];
+            BOARD.cells[cell] = 0;
+            const Difficulty next = gradeDifficulty(BOARD);
+            // Overshot the band, or search is needed and the solution may no longer be unique
+            if (next > target.highest || (next == Difficulty::EXPERT && !hasUniqueSolution(BOARD))) {
+                BOARD.cells[cell] = value;
+                continue;
+            }
+            grade = next;
+            blanks++;
+        }
+        return target.contains(grade);
+    }
+}
+
+bool parseDifficulty(const string& text, Difficulty& grade) {
+    for (const Difficulty& candidate : GRADES) {
+        if (text == difficultyName(candidate)) {
+            grade = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseDifficultyTarget(const string& text, DifficultyTarget& target) {
+    const size_t dash = text.find('-');
+    Difficulty lowest, highest;
+    if (dash == string::npos) {
+        if (!parseDifficulty(text, lowest)) return false;
+        highest = lowest;
+    } else if (!parseDifficulty(text.substr(0, dash), lowest) || !parseDifficulty(text.substr(dash + 1), highest)) {
+        return false;
+    }
+    if (highest < lowest) return false;
+    target.lowest = lowest;
+    target.highest = highest;
+    return true;
+}
+
+bool generateBoardInBand(Board& BOARD, const DifficultyTarget& target, RandomEngine& engine, Difficulty* grade, const int& max_attempts) {
+    Difficulty reached = Difficulty::EASY;
+    bool found = false;
+    for (int attempt = 0; attempt < max_attempts && !found; attempt++) {
+        found = carveInBand(BOARD, target, engine, reached);
+    }
+    if (grade != nullptr) *grade = reached;
+    return found;
+}
+
+PuzzleBank::PuzzleBank(const string& folder) : root(folder) {}
+
+string PuzzleBank::gradePath(const Difficulty& grade) const {
+    return (filesystem::path(root) / (string(difficultyName(grade)) + ".sdk")).string();
+}
+
+bool PuzzleBank::load() {
+    lock_guard<mutex> guard(lock);
+    bool ok = true;
+    for (int g = 0; g < DIFFICULTY_GRADES; g++) {
+        puzzles[g].clear();
+        const string path = gradePath(GRADES[g]);
+        if (!filesystem::exists(path)) continue;
+        CorpusReader reader;
+        if (!reader.open(path)) {
+            ok = false;
+            continue;
+        }
+        puzzles[g].resize(reader.size());
+        for (uint64_t i = 0; i < reader.size(); i++) {
+            if (!reader.read(i, puzzles[g][i])) {
+                cerr << "Corrupt record " << i << " in " << path << endl;
+                puzzles[g].resize(i);
+                ok = false;
+                break;
+            }
+        }
+    }
+    return ok;
+}
+
+bool PuzzleBank::save() {
+    lock_guard<mutex> guard(lock);
+    error_code error;
+    filesystem::create_directories(root, error);
+    CorpusHeader params;
+    params.flags = CORPUS_FLAG_UNIQUE | CORPUS_FLAG_RATED;
+    bool ok = true;
+    for (int g = 0; g < DIFFICULTY_GRADES; g++) {
+        // Write next to the old file and swap it in, so a failed save keeps the previous bank
+        const string path = gradePath(GRADES[g]);
+        const string staging = path + ".tmp";
+        std::remove(staging.c_str());
+        CorpusWriter writer;
+        bool written = writer.open(staging, params);
+        for (const Board& board : puzzles[g]) {
+            if (!written) break;
+            written = writer.append(board);
+        }
+        written = writer.close() && written;
+        if (written) filesystem::rename(staging, path, error);
+        if (!written || error) {
+            cerr << "Failed to save " << path << endl;
+            std::remove(staging.c_str());
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+int PuzzleBank::stock(const DifficultyTarget& target, const int& per_grade, const int& num_workers, const uint64_t& master_seed) {
+    int added = 0;
+    for (int g = 0; g < DIFFICULTY_GRADES; g++) {
+        if (!target.contains(GRADES[g])) continue;
+        const int missing = per_grade - static_cast<int>(size(GRADES[g]));
+        if (missing <= 0) continue;
+
+        DifficultyTarget exact = target;
+        exact.lowest = exact.highest = GRADES[g];
+        vector<Board> fresh(missing);
+        vector<char> found(missing, 0);
+        auto makePuzzle = [&](const int& i) {
+            static thread_local RandomEngine engine;
+            engine.seed(derivePuzzleSeed(master_seed + g, i));
+            found[i] = generateBoardInBand(fresh[i], exact, engine);
+        };
+        if (num_workers == 1) {
+            for (int i = 0; i < missing; i++) makePuzzle(i);
+        } else {
+            ThreadPool pool(num_workers);
+            for (int i = 0; i < missing; i++) pool.submit([&makePuzzle, i]() { makePuzzle(i); });
+            pool.wait();
+        }
+
+        // Added in index order, so the bank is the same for any worker count
+        int failed = 0;
+        for (int i = 0; i < missing; i++) {
+            if (found[i]) add(fresh[i], GRADES[g]);
+            else failed++;
+        }
+        added += missing - failed;
+        if (failed > 0) cerr << failed << " " << difficultyName(GRADES[g]) << " puzzles could not be generated" << endl;
+    }
+    return added;
+}
+
+void PuzzleBank::add(const Board& board, const Difficulty& grade) {
+    if (grade < Difficulty::EASY || grade > Difficulty::EXPERT) return;
+    lock_guard<mutex> guard(lock);
+    puzzles[static_cast<int>(grade)].push_back(board);
+}
+
+bool PuzzleBank::take(const DifficultyTarget& target, Board& board, Difficulty* grade) {
+    lock_guard<mutex> guard(lock);
+    int best = -1;
+    for (int g = 0; g < DIFFICULTY_GRADES; g++) {
+        if (!target.contains(GRADES[g]) || puzzles[g].empty()) continue;
+        if (best < 0 || puzzles[g].size() > puzzles[best].size()) best = g;
+    }
+    if (best < 0) return false;
+    board = puzzles[best].back();
+    puzzles[best].pop_back();
+    if (grade != nullptr) *grade = GRADES[best];
+    return true;
+}
+
+size_t PuzzleBank::size(const Difficulty& grade) const {
+    if (grade < Difficulty::EASY || grade > Difficulty::EXPERT) return 0;
+    lock_guard<mutex> guard(lock);
+    return puzzles[static_cast<int>(grade)].size();
+}
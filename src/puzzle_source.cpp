@@ -0,0 +1,50 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/puzzle_source.h"
+#include <iostream>
+
+using namespace std;
+
+int puzzleIndexFromName(const string& path, const int& fallback) {
+    size_t start = path.find_last_of("/\\");
+    start = start == string::npos ? 0 : start + 1;
+    int index = 0;
+    size_t i = start;
+    // Nine digits at most, so the index cannot overflow an int
+    for (; i < path.size() && i - start < 9 && path[i] >= '0' && path[i] <= '9'; i++) {
+        index = index * 10 + (path[i] - '0');
+    }
+    return i == start ? fallback : index;
+}
+
+DirectorySource::DirectorySource(const string& folder) {
+    error_code error;
+    current = filesystem::directory_iterator(folder, error);
+    if (error) {
+        cerr << "Unable to open folder: " << folder << " (" << error.message() << ")" << endl;
+        return;
+    }
+    open = true;
+}
+
+bool DirectorySource::next(string& path, int& index) {
+    error_code error;
+    for (; current != filesystem::directory_iterator(); current.increment(error)) {
+        if (error) break;
+        if (!current->is_regular_file(error)) continue;
+        path = current->path().string();
+        // Numbered names use at most nine digits, so nameless files cannot reuse their indexes
+        index = puzzleIndexFromName(path, UNNUMBERED_INDEX_BASE + position);
+        position++;
+        current.increment(error);
+        if (error) {
+            cerr << "Unable to list folder (" << error.message() << ")" << endl;
+            current = filesystem::directory_iterator();
+        }
+        return true;
+    }
+    if (error) cerr << "Unable to list folder (" << error.message() << ")" << endl;
+    current = filesystem::directory_iterator();
+    return false;
+}
@@ -0,0 +1,212 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/shard.h"
+#include "../include/corpus.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    uint64_t fnv1a(const string& text) {
+        uint64_t hash = 14695981039346656037ull;
+        for (const char& c : text) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    string withoutTrailingSlash(string path) {
+        while (path.size() > 1 && (path.back() == '/' || path.back() == '\\')) path.pop_back();
+        return path;
+    }
+
+    bool parseCount(const string& text, int& value) {
+        if (text.empty() || text.size() > 9) return false;
+        value = 0;
+        for (const char& c : text) {
+            if (c < '0' || c > '9') return false;
+            value = value * 10 + (c - '0');
+        }
+        return true;
+    }
+
+    bool mergeCorpusSegments(const string& destination, const int& count, const vector<ShardSummary>& parts) {
+        CorpusWriter writer;
+        bool opened = false;
+        const Board blank{};
+        for (int i = 0; i < count; i++) {
+            ShardSpec shard{i, count};
+            const string segment = shardSegmentPath(destination, shard);
+            CorpusReader reader;
+            if (!reader.open(segment)) return false;
+            if (!opened) {
+                std::remove(destination.c_str());  // The merge replaces any earlier result
+                if (!writer.open(destination, reader.header())) return false;
+                opened = true;
+            }
+            Board board;
+            for (uint64_t r = 0; r < reader.size(); r++) {
+                if (!reader.read(r, board) || !writer.append(board)) {
+                    cerr << "Failed to copy record " << r << " of " << segment << endl;
+                    return false;
+                }
+            }
+            for (uint64_t r = reader.size(); r < parts[i].records; r++) {
+                if (!writer.append(blank)) return false;
+            }
+        }
+        return writer.close();
+    }
+
+    bool mergeFolderSegments(const string& destination, const int& count) {
+        error_code error;
+        filesystem::create_directories(destination, error);
+        for (int i = 0; i < count; i++) {
+            ShardSpec shard{i, count};
+            const string segment = shardSegmentPath(destination, shard);
+            for (const filesystem::directory_entry& entry : filesystem::directory_iterator(segment, error)) {
+                if (!entry.is_regular_file()) continue;
+                filesystem::copy_file(entry.path(), filesystem::path(destination) / entry.path().filename(),
+                                      filesystem::copy_options::overwrite_existing, error);
+                if (error) break;
+            }
+            if (error) {
+                cerr << "Failed to merge " << segment << ": " << error.message() << endl;
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+bool parseShardSpec(const string& text, ShardSpec& shard) {
+    const size_t slash = text.find('/');
+    int index, count;
+    if (slash == string::npos || !parseCount(text.substr(0, slash), index) || !parseCount(text.substr(slash + 1), count)) {
+        return false;
+    }
+    if (count < 1 || index >= count) return false;
+    shard.index = index;
+    shard.count = count;
+    return true;
+}
+
+void shardRange(const uint64_t& total, const ShardSpec& shard, uint64_t& begin, uint64_t& end) {
+    if (shard.isWhole()) {
+        begin = 0;
+        end = total;
+        return;
+    }
+    // The first `total % count` shards take one extra record; no product can overflow
+    const uint64_t count = static_cast<uint64_t>(shard.count);
+    const uint64_t index = static_cast<uint64_t>(shard.index);
+    const uint64_t share = total / count, extra = total % count;
+    begin = share * index + (index < extra ? index : extra);
+    end = begin + share + (index < extra ? 1 : 0);
+}
+
+bool inShard(const string& path, const ShardSpec& shard) {
+    if (shard.isWhole()) return true;
+    return fnv1a(filesystem::path(path).filename().string()) % static_cast<uint64_t>(shard.count) ==
+           static_cast<uint64_t>(shard.index);
+}
+
+string shardSegmentPath(const string& destination, const ShardSpec& shard) {
+    const string base = withoutTrailingSlash(destination);
+    // A folder destination keeps its trailing slash, since getFileName() appends to it directly
+    const string slash = base.size() < destination.size() ? "/" : "";
+    return base + ".shard-" + to_string(shard.index) + "-of-" + to_string(shard.count) + slash;
+}
+
+string shardSummaryPath(const string& segment) {
+    return withoutTrailingSlash(segment) + ".summary";
+}
+
+void ShardSummary::add(const ShardSummary& other) {
+    puzzles += other.puzzles;
+    solved += other.solved;
+    written += other.written;
+    quarantined += other.quarantined;
+    search.add(other.search);
+}
+
+bool writeShardSummary(const string& path, const ShardSummary& summary) {
+    ofstream out(path);
+    out << "first_record " << summary.first_record << "\n"
+        << "records " << summary.records << "\n"
+        << "puzzles " << summary.puzzles << "\n"
+        << "solved " << summary.solved << "\n"
+        << "written " << summary.written << "\n"
+        << "quarantined " << summary.quarantined << "\n"
+        << "nodes " << summary.search.nodes << "\n"
+        << "backtracks " << summary.search.backtracks << "\n"
+        << "propagation_steps " << summary.search.propagation_steps << "\n"
+        << "max_depth " << summary.search.max_depth << "\n";
+    out.close();
+    if (!out) {
+        cerr << "Unable to write shard summary: " << path << endl;
+        return false;
+    }
+    return true;
+}
+
+bool readShardSummary(const string& path, ShardSummary& summary) {
+    ifstream in(path);
+    if (!in) {
+        cerr << "Missing shard summary: " << path << endl;
+        return false;
+    }
+    summary = ShardSummary();
+    string key;
+    uint64_t value;
+    while (in >> key >> value) {
+        if (key == "first_record") summary.first_record = value;
+        else if (key == "records") summary.records = value;
+        else if (key == "puzzles") summary.puzzles = value;
+        else if (key == "solved") summary.solved = value;
+        else if (key == "written") summary.written = value;
+        else if (key == "quarantined") summary.quarantined = value;
+        else if (key == "nodes") summary.search.nodes = value;
+        else if (key == "backtracks") summary.search.backtracks = value;
+        else if (key == "propagation_steps") summary.search.propagation_steps = value;
+        else if (key == "max_depth") summary.search.max_depth = static_cast<int>(value);
+    }
+    return true;
+}
+
+void printShardSummary(const ShardSummary& summary) {
+    cout << summary.solved << " puzzles solved, " << summary.written << " written out of " << summary.puzzles
+         << ", " << summary.quarantined << " quarantined" << endl;
+    cout << "search: " << summary.search.nodes << " nodes, " << summary.search.backtracks << " backtracks, max depth "
+         << summary.search.max_depth << ", " << summary.search.propagation_steps << " propagation steps" << endl;
+}
+
+bool mergeShardSegments(const string& destination, const int& count, ShardSummary* merged) {
+    if (count < 1) return false;
+    vector<ShardSummary> parts(count);
+    ShardSummary total;
+    for (int i = 0; i < count; i++) {
+        ShardSpec shard{i, count};
+        const string segment = shardSegmentPath(destination, shard);
+        if (!filesystem::exists(segment)) {
+            cerr << "Missing shard segment: " << segment << endl;
+            return false;
+        }
+        if (!readShardSummary(shardSummaryPath(segment), parts[i])) return false;
+        total.add(parts[i]);
+    }
+    total.records = 0;
+    for (const ShardSummary& part : parts) total.records += part.records;
+
+    const bool folders = filesystem::is_directory(shardSegmentPath(destination, ShardSpec{0, count}));
+    bool ok = folders ? mergeFolderSegments(destination, count) : mergeCorpusSegments(destination, count, parts);
+    if (!ok) return false;
+    if (merged != nullptr) *merged = total;
+    return true;
+}
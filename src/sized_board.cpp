@@ -0,0 +1,44 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/sized_board.h"
+#include <cctype>
+
+using namespace std;
+
+template <int BOX>
+bool parseSizedLine(const string& text, SizedBoard<BOX>& board) {
+    size_t begin = 0, end = text.size();
+    while (begin < end && isspace(static_cast<unsigned char>(text[begin]))) begin++;
+    while (end > begin && isspace(static_cast<unsigned char>(text[end - 1]))) end--;
+    if (end - begin != static_cast<size_t>(SizedBoard<BOX>::CELLS)) return false;
+    for (int i = 0; i < SizedBoard<BOX>::CELLS; i++) {
+        char ch = text[begin + i];
+        int k;
+        if (ch == '0' || ch == '.' || ch == '-') k = 0;
+        else if (ch >= '1' && ch <= '9') k = ch - '0';
+        else if (ch >= 'A' && ch <= 'P') k = ch - 'A' + 10;
+        else if (ch >= 'a' && ch <= 'p') k = ch - 'a' + 10;
+        else return false;
+        if (k > SizedBoard<BOX>::SIZE) return false;
+        board.cells[i] = static_cast<uint8_t>(k);
+    }
+    return true;
+}
+
+template <int BOX>
+void sizedBoardToLine(const SizedBoard<BOX>& board, string& content) {
+    content.resize(SizedBoard<BOX>::CELLS);
+    for (int i = 0; i < SizedBoard<BOX>::CELLS; i++) {
+        content[i] = board.cells[i] == 0 ? '.' : SIZED_SYMBOLS[board.cells[i] - 1];
+    }
+}
+
+template bool parseSizedLine<2>(const string&, SizedBoard<2>&);
+template bool parseSizedLine<3>(const string&, SizedBoard<3>&);
+template bool parseSizedLine<4>(const string&, SizedBoard<4>&);
+template bool parseSizedLine<5>(const string&, SizedBoard<5>&);
+template void sizedBoardToLine<2>(const SizedBoard<2>&, string&);
+template void sizedBoardToLine<3>(const SizedBoard<3>&, string&);
+template void sizedBoardToLine<4>(const SizedBoard<4>&, string&);
+template void sizedBoardToLine<5>(const SizedBoard<5>&, string&);
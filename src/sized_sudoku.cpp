@@ -0,0 +1,335 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/sized_sudoku.h"
+#include "../include/bitops.h"
+#include "../include/sudoku.h"
+#include <algorithm>
+#include <random>
+
+using namespace std;
+
+namespace {
+    template <int BOX>
+    struct SizedState {
+        typedef typename BoardGeometry<BOX>::Mask Mask;
+        Mask rows[BoardGeometry<BOX>::SIZE];
+        Mask cols[BoardGeometry<BOX>::SIZE];
+        Mask boxes[BoardGeometry<BOX>::SIZE];
+        int trail[BoardGeometry<BOX>::CELLS];  // Cells placed since the givens, in order
+        int trailSize = 0;
+
+        Mask candidates(const int& cell) const {
+            typedef BoardGeometry<BOX> G;
+            return static_cast<Mask>(G::ALL & ~(rows[G::row(cell)] | cols[G::col(cell)] | boxes[G::box(cell)]));
+        }
+
+        // Digits already placed in unit u (rows 0..SIZE-1, then columns, then boxes)
+        Mask placedIn(const int& unit) const {
+            typedef BoardGeometry<BOX> G;
+            if (unit < G::SIZE) return rows[unit];
+            if (unit < 2 * G::SIZE) return cols[unit - G::SIZE];
+            return boxes[unit - 2 * G::SIZE];
+        }
+
+        void toggle(const int& cell, const Mask& bit) {
+            typedef BoardGeometry<BOX> G;
+            rows[G::row(cell)] ^= bit;
+            cols[G::col(cell)] ^= bit;
+            boxes[G::box(cell)] ^= bit;
+        }
+    };
+
+    // Cell i (0..SIZE-1) of unit u, numbered as in SizedState::placedIn()
+    template <int BOX>
+    int unitCell(const int& unit, const int& i) {
+        typedef BoardGeometry<BOX> G;
+        if (unit < G::SIZE) return unit * G::SIZE + i;
+        if (unit < 2 * G::SIZE) return i * G::SIZE + unit - G::SIZE;
+        const int b = unit - 2 * G::SIZE;
+        return ((b / BOX) * BOX + i / BOX) * G::SIZE + (b % BOX) * BOX + i % BOX;
+    }
+
+    // Loads the givens; false if a digit is out of range or clashes with another
+    template <int BOX>
+    bool initSizedState(const SizedBoard<BOX>& board, SizedState<BOX>& state) {
+        typedef BoardGeometry<BOX> G;
+        typedef typename G::Mask Mask;
+        for (int i = 0; i < G::SIZE; i++) state.rows[i] = state.cols[i] = state.boxes[i] = 0;
+        state.trailSize = 0;
+        for (int cell = 0; cell < G::CELLS; cell++) {
+            int k = board.cells[cell];
+            if (k == 0) continue;
+            if (k > G::SIZE) return false;
+            Mask bit = static_cast<Mask>(Mask(1) << (k - 1));
+            if (~state.candidates(cell) & bit) return false;
+            state.toggle(cell, bit);
+        }
+        return true;
+    }
+
+    template <int BOX>
+    void placeSized(SizedBoard<BOX>& board, SizedState<BOX>& state, const int& cell, const typename BoardGeometry<BOX>::Mask& bit) {
+        state.toggle(cell, bit);
+        board.cells[cell] = static_cast<uint8_t>(lowestBit(bit) + 1);
+        state.trail[state.trailSize++] = cell;
+    }
+
+    // Takes back every placement after the first `mark` of the trail
+    template <int BOX>
+    void undoSized(SizedBoard<BOX>& board, SizedState<BOX>& state, const int& mark) {
+        typedef typename BoardGeometry<BOX>::Mask Mask;
+        while (state.trailSize > mark) {
+            const int cell = state.trail[--state.trailSize];
+            state.toggle(cell, static_cast<Mask>(Mask(1) << (board.cells[cell] - 1)));
+            board.cells[cell] = 0;
+        }
+    }
+
+    // Naked and hidden singles to a fixed point, as deduce() does for 9x9; false on a contradiction
+    // (an empty cell without candidates, or a digit with no place left in a unit)
+    template <int BOX>
+    bool propagateSized(SizedBoard<BOX>& board, SizedState<BOX>& state, uint64_t& steps) {
+        typedef BoardGeometry<BOX> G;
+        typedef typename G::Mask Mask;
+        bool progress = true;
+        while (progress) {
+            progress = false;
+            for (int cell = 0; cell < G::CELLS; cell++) {
+                if (board.cells[cell] != 0) continue;
+                const Mask options = state.candidates(cell);
+                if (options == 0) return false;
+                if (options & (options - 1)) continue;
+                placeSized(board, state, cell, options);
+                steps++;
+                progress = true;
+            }
+            for (int unit = 0; unit < 3 * G::SIZE; unit++) {
+                Mask once = 0, twice = 0;
+                for (int i = 0; i < G::SIZE; i++) {
+                    const int cell = unitCell<BOX>(unit, i);
+                    if (board.cells[cell] != 0) continue;
+                    const Mask options = state.candidates(cell);
+                    twice |= once & options;
+                    once |= options;
+                }
+                if ((once | state.placedIn(unit)) != G::ALL) return false;
+                Mask singles = static_cast<Mask>(once & ~twice);
+                for (; singles; singles &= static_cast<Mask>(singles - 1)) {
+                    const Mask bit = static_cast<Mask>(singles & (~singles + 1));
+                    int i = 0;
+                    while (i < G::SIZE && (board.cells[unitCell<BOX>(unit, i)] != 0 ||
+                                           !(state.candidates(unitCell<BOX>(unit, i)) & bit))) i++;
+                    if (i == G::SIZE) return false;  // An earlier single of this unit took its only cell
+                    placeSized(board, state, unitCell<BOX>(unit, i), bit);
+                    steps++;
+                    progress = true;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Fewest-candidates empty cell, or -1 if the board is full
+    template <int BOX>
+    int selectSized(const SizedBoard<BOX>& board, const SizedState<BOX>& state) {
+        typedef BoardGeometry<BOX> G;
+        int best = -1;
+        int bestCount = G::SIZE + 1;
+        for (int cell = 0; cell < G::CELLS && bestCount > 2; cell++) {
+            if (board.cells[cell] != 0) continue;
+            const int count = countBits(state.candidates(cell));
+            if (count < bestCount) {
+                bestCount = count;
+                best = cell;
+            }
+        }
+        return best;
+    }
+
+    // Iterative MRV search with propagation after every guess. Level `depth` keeps its cell, the
+    // untried digits and the trail length before its guess, so backtracking undoes the guess
+    // together with everything propagation placed after it
+    template <int BOX, typename Recorder>
+    bool searchSized(SizedBoard<BOX>& board, SizedState<BOX>& state, Recorder& recorder) {
+        typedef BoardGeometry<BOX> G;
+        typedef typename G::Mask Mask;
+        struct Level {
+            int cell;
+            Mask options;
+            int mark;
+        };
+        Level levels[G::CELLS];
+        uint64_t steps = 0;
+        uint64_t start = recorder.clock();
+        bool consistent = propagateSized(board, state, steps);
+        recorder.addPropagation(start);
+        recorder.propagated(steps);
+        if (!consistent) return false;
+
+        int depth = 0;
+        while (true) {
+            start = recorder.clock();
+            const int cell = selectSized(board, state);
+            recorder.addSelection(start);
+            if (cell < 0) return true;
+            levels[depth] = Level{cell, state.candidates(cell), state.trailSize};
+
+            while (true) {
+                Level& level = levels[depth];
+                if (state.trailSize > level.mark) {
+                    start = recorder.clock();
+                    undoSized(board, state, level.mark);
+                    recorder.addPlacement(start);
+                    recorder.backtrack();
+                }
+                if (level.options == 0) {
+                    if (depth == 0) return false;
+                    depth--;
+                    continue;
+                }
+                if (recorder.stop()) return false;  // Budget used up; the caller restores the board
+                const Mask bit = static_cast<Mask>(level.options & (~level.options + 1));
+                level.options = static_cast<Mask>(level.options & (level.options - 1));
+
+                recorder.node(depth + 1);
+                start = recorder.clock();
+                placeSized(board, state, level.cell, bit);
+                recorder.addPlacement(start);
+                steps = 0;
+                start = recorder.clock();
+                consistent = propagateSized(board, state, steps);
+                recorder.addPropagation(start);
+                recorder.propagated(steps);
+                if (consistent) break;
+            }
+            depth++;
+        }
+    }
+}
+
+template <int BOX>
+bool isValid(const SizedBoard<BOX>& board, const int& r, const int& c, const int& k) {
+    typedef BoardGeometry<BOX> G;
+    const int br = r - r % BOX, bc = c - c % BOX;
+    for (int i = 0; i < G::SIZE; i++) {
+        if (board(r, i) == k || board(i, c) == k) return false;
+        if (board(br + i / BOX, bc + i % BOX) == k) return false;
+    }
+    return true;
+}
+
+template <int BOX>
+bool checkIfSolutionIsValid(const SizedBoard<BOX>& board) {
+    typedef BoardGeometry<BOX> G;
+    typedef typename G::Mask Mask;
+    Mask rows[G::SIZE] = {0}, cols[G::SIZE] = {0}, boxes[G::SIZE] = {0};
+    for (int cell = 0; cell < G::CELLS; cell++) {
+        const int k = board.cells[cell];
+        if (k < 1 || k > G::SIZE) return false;
+        const Mask bit = static_cast<Mask>(Mask(1) << (k - 1));
+        rows[G::row(cell)] |= bit;
+        cols[G::col(cell)] |= bit;
+        boxes[G::box(cell)] |= bit;
+    }
+    Mask all = G::ALL;
+    for (int u = 0; u < G::SIZE; u++) all &= rows[u] & cols[u] & boxes[u];
+    return all == G::ALL;
+}
+
+template <int BOX, typename Recorder>
+bool solveSized(SizedBoard<BOX>& board, Recorder& recorder) {
+    if constexpr (BOX == 3) {
+        // The classic size keeps its tuned engine
+        Board classic = toBoard(board);
+        bool solved = solveWithRecorder(classic, SolverType::BITMASK, recorder);
+        board = toSizedBoard(classic);
+        return solved;
+    } else {
+        SizedState<BOX> state;
+        if (!initSizedState(board, state)) return false;
+        return searchSized(board, state, recorder);
+    }
+}
+
+template <int BOX>
+bool solveSized(SizedBoard<BOX>& board) {
+    NullRecorder recorder;
+    return solveSized(board, recorder);
+}
+
+template <int BOX>
+SolveStatus solveSizedWithinBudget(SizedBoard<BOX>& board, const SolveBudget& budget) {
+    const SizedBoard<BOX> original = board;
+    NullRecorder inner;
+    BudgetRecorder<NullRecorder> recorder(inner, budget);
+    if (solveSized(board, recorder)) return SolveStatus::SOLVED;
+    board = original;
+    return recorder.exceeded ? SolveStatus::BUDGET_EXCEEDED : SolveStatus::UNSOLVABLE;
+}
+
+template <int BOX>
+void generateSolvedSizedGrid(SizedBoard<BOX>& board, RandomEngine& engine) {
+    typedef BoardGeometry<BOX> G;
+    // Start from the banded pattern grid and shuffle it with validity-preserving moves:
+    // bands, rows within a band, stacks, columns within a stack, and a digit relabel.
+    // Unlike filling the diagonal boxes and solving, this never hits a dead end and costs
+    // nothing for 25x25.
+    int rows[G::SIZE], cols[G::SIZE], bands[BOX], stacks[BOX];
+    uint8_t digits[G::SIZE];
+    for (int b = 0; b < BOX; b++) bands[b] = stacks[b] = b;
+    for (int d = 0; d < G::SIZE; d++) digits[d] = static_cast<uint8_t>(d + 1);
+    shuffle(bands, bands + BOX, engine);
+    shuffle(stacks, stacks + BOX, engine);
+    shuffle(digits, digits + G::SIZE, engine);
+    for (int b = 0; b < BOX; b++) {
+        int inner[BOX];
+        for (int i = 0; i < BOX; i++) inner[i] = i;
+        shuffle(inner, inner + BOX, engine);
+        for (int i = 0; i < BOX; i++) rows[b * BOX + i] = bands[b] * BOX + inner[i];
+        shuffle(inner, inner + BOX, engine);
+        for (int i = 0; i < BOX; i++) cols[b * BOX + i] = stacks[b] * BOX + inner[i];
+    }
+    for (int r = 0; r < G::SIZE; r++) {
+        const int pr = rows[r];
+        for (int c = 0; c < G::SIZE; c++) {
+            board(r, c) = digits[(BOX * (pr % BOX) + pr / BOX + cols[c]) % G::SIZE];
+        }
+    }
+}
+
+template <int BOX>
+void generateSizedBoard(SizedBoard<BOX>& board, const int& empty_boxes, RandomEngine& engine) {
+    typedef BoardGeometry<BOX> G;
+    generateSolvedSizedGrid(board, engine);
+    int cells[G::CELLS];
+    for (int i = 0; i < G::CELLS; i++) cells[i] = i;
+    const int picks = max(0, min(empty_boxes, G::CELLS));
+    // Partial Fisher-Yates, as in selectRandomCells()
+    for (int i = 0; i < picks; i++) {
+        uniform_int_distribution<int> pick(i, G::CELLS - 1);
+        swap(cells[i], cells[pick(engine)]);
+        board.cells[cells[i]] = 0;
+    }
+}
+
+#define SUDOKU_INSTANTIATE_SIZED_RECORDER(BOX, RECORDER) \
+    template bool solveSized<BOX, RECORDER>(SizedBoard<BOX>&, RECORDER&);
+
+#define SUDOKU_INSTANTIATE_SIZED(BOX) \
+    template bool isValid<BOX>(const SizedBoard<BOX>&, const int&, const int&, const int&); \
+    template bool checkIfSolutionIsValid<BOX>(const SizedBoard<BOX>&); \
+    template bool solveSized<BOX>(SizedBoard<BOX>&); \
+    template SolveStatus solveSizedWithinBudget<BOX>(SizedBoard<BOX>&, const SolveBudget&); \
+    template void generateSolvedSizedGrid<BOX>(SizedBoard<BOX>&, RandomEngine&); \
+    template void generateSizedBoard<BOX>(SizedBoard<BOX>&, const int&, RandomEngine&); \
+    SUDOKU_INSTANTIATE_SIZED_RECORDER(BOX, NullRecorder) \
+    SUDOKU_INSTANTIATE_SIZED_RECORDER(BOX, CountingRecorder) \
+    SUDOKU_INSTANTIATE_SIZED_RECORDER(BOX, TimingRecorder) \
+    SUDOKU_INSTANTIATE_SIZED_RECORDER(BOX, BudgetRecorder<NullRecorder>) \
+    SUDOKU_INSTANTIATE_SIZED_RECORDER(BOX, BudgetRecorder<CountingRecorder>)
+
+SUDOKU_INSTANTIATE_SIZED(2)
+SUDOKU_INSTANTIATE_SIZED(3)
+SUDOKU_INSTANTIATE_SIZED(4)
+SUDOKU_INSTANTIATE_SIZED(5)
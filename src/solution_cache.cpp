@@ -0,0 +1,97 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/solution_cache.h"
+#include <cstring>
+
+using namespace std;
+
+bool SolutionCache::Key::operator==(const Key& other) const {
+    return memcmp(bytes, other.bytes, sizeof(bytes)) == 0;
+}
+
+size_t SolutionCache::KeyHash::operator()(const Key& key) const {
+    // 64-bit FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (const uint8_t& byte : key.bytes) {
+        hash ^= byte;
+        hash *= 1099511628211ull;
+    }
+    return static_cast<size_t>(hash);
+}
+
+SolutionCache::SolutionCache(const size_t& capacity, const int& num_shards) {
+    const int count = num_shards > 0 ? num_shards : 1;
+    for (int i = 0; i < count; i++) shards.push_back(unique_ptr<Shard>(new Shard()));
+    shard_capacity = capacity / count > 0 ? capacity / count : 1;
+}
+
+SolutionCache::Shard& SolutionCache::shardOf(const size_t& hash) {
+    // The low bits pick the bucket inside a shard, so use the high ones here
+    return *shards[(hash >> 48) % shards.size()];
+}
+
+bool SolutionCache::find(const CanonicalBoard& form, Board& solution) {
+    Key key;
+    packBoard(form.board, key.bytes);
+    Shard& shard = shardOf(KeyHash()(key));
+
+    Board canonical_solution;
+    {
+        lock_guard<mutex> guard(shard.lock);
+        auto found = shard.index.find(key);
+        if (found == shard.index.end()) {
+            miss_count++;
+            return false;
+        }
+        shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+        unpackBoard(found->second->solution, canonical_solution);
+    }
+    hit_count++;
+    untransformBoard(canonical_solution, form.transform, solution);
+    return true;
+}
+
+void SolutionCache::store(const CanonicalBoard& form, const Board& solution) {
+    Entry entry;
+    packBoard(form.board, entry.key.bytes);
+    Board canonical_solution;
+    transformBoard(solution, form.transform, canonical_solution);
+    packBoard(canonical_solution, entry.solution);
+    Shard& shard = shardOf(KeyHash()(entry.key));
+
+    lock_guard<mutex> guard(shard.lock);
+    auto found = shard.index.find(entry.key);
+    if (found != shard.index.end()) {
+        // Keep the stored solution; it solves the same canonical board
+        shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+        return;
+    }
+    if (shard.entries.size() >= shard_capacity) {
+        shard.index.erase(shard.entries.back().key);
+        shard.entries.pop_back();
+    }
+    shard.entries.push_front(entry);
+    shard.index[entry.key] = shard.entries.begin();
+}
+
+bool SolutionCache::lookup(const Board& puzzle, Board& solution) {
+    CanonicalBoard form;
+    canonicalForm(puzzle, form);
+    return find(form, solution);
+}
+
+void SolutionCache::insert(const Board& puzzle, const Board& solution) {
+    CanonicalBoard form;
+    canonicalForm(puzzle, form);
+    store(form, solution);
+}
+
+size_t SolutionCache::size() const {
+    size_t total = 0;
+    for (const unique_ptr<Shard>& shard : shards) {
+        lock_guard<mutex> guard(shard->lock);
+        total += shard->entries.size();
+    }
+    return total;
+}
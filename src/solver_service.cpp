@@ -0,0 +1,367 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/solver_service.h"
+#include "../include/batch_solver.h"
+#include "../include/sudoku_parser.h"
+#include "../include/pipeline.h"
+#include "../include/metrics.h"
+#include <cstring>
+#include <sstream>
+#include <streambuf>
+#include <vector>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <cerrno>
+#include <csignal>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace {
+    struct ServiceEntry {
+        Board board;
+        bool parsed = false;
+        SolveStatus status = SolveStatus::UNSOLVABLE;
+        string error;  // Parser message when !parsed
+    };
+
+    struct ServiceChunk {
+        vector<ServiceEntry> entries;
+    };
+
+    void solveChunk(ServiceChunk& chunk, const ServiceConfig& config, const SolveBudget& budget, SolutionCache* cache) {
+        vector<Board> boards;
+        boards.reserve(chunk.entries.size());
+        for (const ServiceEntry& entry : chunk.entries) {
+            if (entry.parsed) boards.push_back(entry.board);
+        }
+        vector<SolveStatus> status(boards.size());
+        SolverStats stats;
+        {
+            StageTimer timer(Stage::SOLVE, boards.size());
+            solveBatch(boards.data(), static_cast<int>(boards.size()), status.data(), config.fallback, budget, stats, cache);
+        }
+
+        size_t k = 0;
+        for (ServiceEntry& entry : chunk.entries) {
+            if (!entry.parsed) continue;
+            entry.board = boards[k];
+            entry.status = status[k++];
+        }
+    }
+
+    void writeEntry(const ServiceEntry& entry, ostream& out, string& line, ServiceSummary& summary) {
+        summary.puzzles++;
+        if (!entry.parsed) {
+            summary.malformed++;
+            out << "error: " << entry.error << '\n';
+            return;
+        }
+        switch (entry.status) {
+            case SolveStatus::SOLVED:
+                summary.solved++;
+                boardToLine(entry.board, line);
+                out << line << '\n';
+                return;
+            case SolveStatus::UNSOLVABLE:
+                summary.unsolvable++;
+                break;
+            case SolveStatus::BUDGET_EXCEEDED:
+                summary.budget_exceeded++;
+                break;
+        }
+        out << solveStatusName(entry.status) << '\n';
+    }
+}
+
+void ServiceSummary::add(const ServiceSummary& other) {
+    puzzles += other.puzzles;
+    solved += other.solved;
+    unsolvable += other.unsolvable;
+    budget_exceeded += other.budget_exceeded;
+    malformed += other.malformed;
+}
+
+void printServiceSummary(const ServiceSummary& summary, ostream& out) {
+    out << summary.puzzles << " puzzles served: " << summary.solved << " solved, "
+        << summary.unsolvable << " unsolvable, " << summary.budget_exceeded << " over budget, "
+        << summary.malformed << " malformed" << endl;
+}
+
+SolverService::SolverService(const ServiceConfig& config) : settings(config), pool(config.num_workers) {
+    if (settings.cache_capacity > 0) solutions.reset(new SolutionCache(settings.cache_capacity));
+}
+
+ServiceSummary SolverService::serve(istream& input, ostream& output) {
+    // Whole batches only, so no chunk leaves SIMD lanes idle except the one before a pause in the input
+    const int requested = settings.chunk_size > 0 ? settings.chunk_size : 1;
+    const size_t chunk_size = static_cast<size_t>((requested + BATCH_LANES - 1) / BATCH_LANES * BATCH_LANES);
+    const size_t max_in_flight = static_cast<size_t>(settings.max_in_flight > 0 ? settings.max_in_flight : 4 * pool.size());
+    const SolveBudget budget = settings.node_budget == 0 ? SolveBudget() : SolveBudget::nodes(settings.node_budget);
+    SolutionCache* cache = solutions.get();
+
+    ServiceSummary summary;
+    string line;
+    int line_number = 0;
+    auto readChunk = [&](ServiceChunk& chunk) {
+        chunk.entries.clear();
+        chunk.entries.reserve(chunk_size);
+        ServiceEntry entry;
+        while (chunk.entries.size() < chunk_size && getline(input, line)) {
+            line_number++;
+            if (line.find_first_not_of(" \t\r") != string::npos) {
+                StageTimer timer(Stage::PARSE);
+                entry.parsed = parseSudokuLine(line, entry.board);
+                entry.error = entry.parsed ? string() : "line " + to_string(line_number) + ": expected 81 cells of 1-9, 0, . or -";
+                chunk.entries.push_back(entry);
+            }
+            // Solve what we have rather than block on input that may not come for a while
+            if (!chunk.entries.empty() && input.rdbuf()->in_avail() <= 0) break;
+        }
+        return !chunk.entries.empty();
+    };
+    string text;
+    auto writeChunk = [&](ServiceChunk& chunk, const bool& caught_up) {
+        {
+            StageTimer timer(Stage::WRITE, chunk.entries.size());
+            for (const ServiceEntry& entry : chunk.entries) writeEntry(entry, output, text, summary);
+        }
+        // Nothing else is ready yet: hand over what there is instead of holding it back
+        if (caught_up) output.flush();
+    };
+    runOrderedPipeline<ServiceChunk>(pool, max_in_flight, readChunk,
+                                     [&](ServiceChunk& chunk) { solveChunk(chunk, settings, budget, cache); }, writeChunk);
+    output.flush();
+    return summary;
+}
+
+#ifndef _WIN32
+namespace {
+    /**
+     * Buffered stream over a connected socket; reads and writes use separate buffers, so one
+     * thread may read while another writes.
+     */
+    class SocketStreamBuf : public streambuf {
+    public:
+        explicit SocketStreamBuf(const int& socket_fd) : fd(socket_fd) {
+            setg(in_buffer, in_buffer, in_buffer);
+            setp(out_buffer, out_buffer + sizeof(out_buffer));
+        }
+
+        ~SocketStreamBuf() override { flushOutput(); }
+
+    protected:
+        int_type underflow() override {
+            ssize_t n;
+            do {
+                n = ::read(fd, in_buffer, sizeof(in_buffer));
+            } while (n < 0 && errno == EINTR);
+            if (n <= 0) return traits_type::eof();
+            setg(in_buffer, in_buffer, in_buffer + n);
+            return traits_type::to_int_type(in_buffer[0]);
+        }
+
+        int_type overflow(int_type ch) override {
+            if (!flushOutput()) return traits_type::eof();
+            if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+                *pptr() = traits_type::to_char_type(ch);
+                pbump(1);
+            }
+            return traits_type::not_eof(ch);
+        }
+
+        int sync() override { return flushOutput() ? 0 : -1; }
+
+    private:
+        int fd;
+        char in_buffer[1 << 16];
+        char out_buffer[1 << 16];
+
+        bool flushOutput() {
+            const char* data = pbase();
+            size_t left = static_cast<size_t>(pptr() - pbase());
+            while (left > 0) {
+                ssize_t n = ::write(fd, data, left);
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) return false;
+                data += n;
+                left -= static_cast<size_t>(n);
+            }
+            setp(out_buffer, out_buffer + sizeof(out_buffer));
+            return true;
+        }
+    };
+
+    int openUnixListener(const string& path) {
+        sockaddr_un address{};
+        if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+            cerr << "Invalid socket path: " << path << endl;
+            return -1;
+        }
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+        address.sun_family = AF_UNIX;
+        memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        ::unlink(path.c_str());  // A stale socket from an earlier run
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    int openTcpListener(const string& host, const string& port) {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        char* end = nullptr;
+        long number = strtol(port.c_str(), &end, 10);
+        if (port.empty() || *end != '\0' || number < 0 || number > 65535 ||
+            ::inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+            cerr << "Invalid TCP address: " << host << ":" << port << endl;
+            return -1;
+        }
+        address.sin_port = htons(static_cast<uint16_t>(number));
+        int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    int openListener(const string& address) {
+        int fd = -1;
+        if (address.compare(0, 5, "unix:") == 0) {
+            fd = openUnixListener(address.substr(5));
+        } else if (address.compare(0, 4, "tcp:") == 0) {
+            string rest = address.substr(4);
+            size_t colon = rest.rfind(':');
+            if (colon == string::npos) fd = openTcpListener("127.0.0.1", rest);
+            else fd = openTcpListener(rest.substr(0, colon), rest.substr(colon + 1));
+        } else {
+            cerr << "Unknown socket address (expected unix:PATH or tcp:[HOST:]PORT): " << address << endl;
+            return -1;
+        }
+        if (fd >= 0 && ::listen(fd, 16) != 0) {
+            ::close(fd);
+            fd = -1;
+        }
+        if (fd < 0 && errno != 0) cerr << "Unable to listen on " << address << ": " << strerror(errno) << endl;
+        return fd;
+    }
+}
+
+bool runSocketService(const string& address, const ServiceConfig& config) {
+    errno = 0;
+    int listener = openListener(address);
+    if (listener < 0) return false;
+    // A client that hangs up early must not take the service down with it
+    signal(SIGPIPE, SIG_IGN);
+
+    SolverService service(config);
+    cerr << "Serving on " << address << " with " << resolveWorkerCount(config.num_workers) << " workers" << endl;
+    ServiceSummary total;
+    while (true) {
+        int client = ::accept(listener, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR) continue;
+            cerr << "accept failed: " << strerror(errno) << endl;
+            break;
+        }
+        ServiceSummary summary;
+        {
+            SocketStreamBuf buffer(client);
+            istream in(&buffer);
+            ostream out(&buffer);
+            summary = service.serve(in, out);
+        }
+        ::close(client);
+        total.add(summary);
+        printServiceSummary(summary, cerr);
+    }
+    ::close(listener);
+    printServiceSummary(total, cerr);
+    return false;
+}
+
+namespace {
+    bool writeAll(const int& fd, const string& data) {
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t n = ::write(fd, data.data() + sent, data.size() - sent);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            sent += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    // Any request gets the metrics; the request is read first so the client sees a clean close
+    void answerMetricsRequest(const int& client) {
+        timeval timeout{1, 0};  // A client that never finishes its request cannot stall the endpoint
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        string request;
+        char buffer[1024];
+        while (request.size() < 8192 && request.find("\r\n\r\n") == string::npos) {
+            ssize_t n = ::read(client, buffer, sizeof(buffer));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) break;
+            request.append(buffer, static_cast<size_t>(n));
+        }
+        ostringstream body;
+        writePrometheusMetrics(collectMetrics(), body);
+        const string text = body.str();
+        writeAll(client, "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+                         to_string(text.size()) + "\r\nConnection: close\r\n\r\n" + text);
+    }
+}
+
+bool MetricsEndpoint::open(const string& address) {
+    errno = 0;
+    listener = openListener(address);
+    if (listener < 0) return false;
+    signal(SIGPIPE, SIG_IGN);
+    const int fd = listener;
+    worker = thread([fd]() {
+        while (true) {
+            int client = ::accept(fd, nullptr, nullptr);
+            if (client < 0) {
+                if (errno == EINTR) continue;
+                return;  // Closed by the destructor
+            }
+            answerMetricsRequest(client);
+            ::close(client);
+        }
+    });
+    return true;
+}
+
+MetricsEndpoint::~MetricsEndpoint() {
+    if (listener < 0) return;
+    ::shutdown(listener, SHUT_RDWR);  // Wakes the accept() of the worker
+    worker.join();
+    ::close(listener);
+}
+#else
+bool runSocketService(const string& address, const ServiceConfig& config) {
+    cerr << "Socket service is not supported on this platform: " << address << endl;
+    return false;
+}
+
+bool MetricsEndpoint::open(const string& address) {
+    cerr << "Metrics endpoint is not supported on this platform: " << address << endl;
+    return false;
+}
+
+MetricsEndpoint::~MetricsEndpoint() {}
+#endif
@@ -14,9 +14,15 @@
  */
 
  #include "../include/sudoku.h"
+ #include "../include/board.h"
  #include <iostream>
  #include <tuple>
  #include <climits>
+ #include "../include/bitops.h"
+ #include "../include/cell_selection.h"
+ #include "../include/geometry.h"
+ #include "../include/dlx.h"
+ #include "../include/deduction.h"
  using namespace std;
 
  bool isValid(int** BOARD, const int& r, const int& c, const int& k)
@@ -28,9 +34,10 @@
              return false;  // Invalid placement
      }
 
-     // Determine starting indices for the 3x3 subgrid
-     int startRow = 3 * (r / 3);
-     int startCol = 3 * (c / 3);
+     // The 3x3 subgrid starts at the first cell of the box unit of (r, c)
+     const int origin = UNIT_TABLE.cells[UNIT_TABLE.of[r * 9 + c][2]][0];
+     const int startRow = PEER_TABLE.row[origin];
+     const int startCol = PEER_TABLE.col[origin];
 
      // Check if 'k' exists in the 3x3 subgrid
      for (int i = startRow; i < startRow + 3; i++)
@@ -45,43 +52,94 @@
      return true;  // Placement is valid
  }
 
- bool solveBoard(int** BOARD, const int& r, const int& c)
+ bool isValid(const Board& BOARD, const int& r, const int& c, const int& k)
  {
-     // If we've reached beyond the last row, the board is solved
-     if (r == 9)
-         return true;
+     // Check if 'k' already exists in the same row or column
+     const uint8_t* row = BOARD.cells + r * 9;
+     for (int i = 0; i < 9; i++)
+     {
+         if (k == row[i] || k == BOARD.cells[i * 9 + c])
+             return false;  // Invalid placement
+     }
 
-     // Move to the next row if we've reached the end of the current row
-     if (c == 9)
-         return solveBoard(BOARD, r + 1, 0);
+     // The 3x3 subgrid sits at fixed offsets 0, 1, 2, 9, ... 20 from the first cell of the box unit
+     const uint8_t* box = BOARD.cells + UNIT_TABLE.cells[UNIT_TABLE.of[r * 9 + c][2]][0];
+     for (int i = 0; i < 27; i += 9)
+     {
+         if (k == box[i] || k == box[i + 1] || k == box[i + 2])
+             return false;  // Invalid placement
+     }
 
-     // Skip already filled cells and move to the next column
-     if (BOARD[r][c] != 0)
-         return solveBoard(BOARD, r, c + 1);
+     return true;  // Placement is valid
+ }
 
-     // Try placing numbers 1 to 9 in the current empty cell
-     for (int k = 1; k <= 9; k++)
-     {
-         if (isValid(BOARD, r, c, k))
-         {
-             BOARD[r][c] = k;  // Place number 'k'
+namespace {
+    // Row-major backtracking behind solveBoard(), starting at (r, c). Iterative: level i of the
+    // explicit stack is the i-th empty cell and digit[i] the digit currently placed there (0 = none).
+    template <typename Recorder>
+    bool searchRowMajor(Board& BOARD, const int& r, const int& c, Recorder& recorder)
+    {
+        // Filled cells never need a stack entry, so only the empty cells are listed
+        int cells[81];
+        int digit[81];
+        int count = 0;
+        for (int cell = r * 9 + c; cell < 81; cell++) {
+            if (BOARD.cells[cell] == 0) cells[count++] = cell;
+        }
 
-             // Recursively attempt to solve the rest of the board
-             if (solveBoard(BOARD, r, c + 1))
-                 return true;  // Found a valid solution
+        int level = 0;
+        if (count > 0) digit[0] = 0;
+        while (level < count)
+        {
+            int row = cells[level] / 9, col = cells[level] % 9;
 
-             // Backtrack: Remove the number if no solution is found
-             BOARD[r][c] = 0;
-         }
-     }
+            // Backtrack: Remove the number that led to a dead end
+            if (digit[level] != 0)
+            {
+                BOARD(row, col) = 0;
+                recorder.backtrack();
+            }
 
-     // Trigger backtracking if no valid number can be placed
-     return false;
+            // Try the next numbers up to 9 in the current empty cell
+            int k = digit[level] + 1;
+            for (; k <= 9; k++)
+            {
+                uint64_t start = recorder.clock();
+                bool valid = isValid(BOARD, row, col, k);
+                recorder.addPlacement(start);
+                if (valid) break;
+            }
+
+            if (k > 9)
+            {
+                // No valid number can be placed: return to the previous empty cell
+                digit[level] = 0;
+                if (level == 0) return false;
+                level--;
+                continue;
+            }
+
+            if (recorder.stop()) return false;  // Budget used up; the caller restores the board
+            recorder.node(level + 1);
+            BOARD(row, col) = k;  // Place number 'k'
+            digit[level++] = k;
+            if (level < count) digit[level] = 0;
+        }
+
+        // Every empty cell holds a valid number, the board is solved
+        return true;
+    }
+}
+
+ bool solveBoard(Board& BOARD, const int& r, const int& c)
+ {
+     NullRecorder recorder;
+     return searchRowMajor(BOARD, r, c, recorder);
  }
 
 
 
- tuple<int, int, int> findNextCell(int** BOARD) {
+ tuple<int, int, int> findNextCell(const Board& BOARD) {
     /**
      * @brief Finds the next empty cell using the Minimum Remaining Value (MRV) heuristic.
      *
@@ -132,7 +190,7 @@
              * - Track the cell with the minimum number of options.
              * - Implement early exit if a cell with only one option is found.
              */
-            if (BOARD[r][c] == 0) {
+            if (BOARD(r, c) == 0) {
                 int optionsCount = 0;
                 for (int k = 1; k <= 9; k++) {
                     if (isValid(BOARD, r, c, k)) {
@@ -159,55 +217,357 @@
      return {bestRow, bestCol, minOptions};
 }
 
-bool solveBoardEfficient(int** BOARD)
+namespace {
+    template <typename Recorder>
+    bool solveEfficientWith(Board& BOARD, Recorder& recorder) {
+        DeductionReport report;
+        uint64_t start = recorder.clock();
+        bool consistent = deduce(BOARD, report);
+        recorder.addPropagation(start);
+        recorder.propagated(report.naked_singles + report.hidden_singles + report.locked_candidates);
+        if (!consistent) return false;
+        if (report.open_cells == 0) return true;
+        return solveBoardWithSelection<MrvSelection>(BOARD, recorder);
+    }
+}
+
+bool solveBoardEfficient(Board& BOARD)
  {
      /**
       * @brief Efficiently solves the Sudoku board using backtracking and the MRV heuristic.
       *
-      * This function uses a recursive backtracking approach combined with the Minimum Remaining Value (MRV)
-      * heuristic to optimize the solving process by always selecting the cell with the fewest valid options.
+      * The MRV choice is maintained incrementally by a `CandidateTracker`: placing or removing a digit
+      * only updates the candidate counts of the 20 peers of that cell, and the next cell is taken from
+      * the lowest non-empty count bucket instead of re-running `findNextCell()` over the whole board.
       *
-      * TODO:
-      * - Implement the backtracking logic using the following steps:
-      *   1. Use `findNextCell(BOARD)` to select the next cell with the fewest valid options.
-      *   2. If no empty cells are left, the board is solved.
-      *   3. Try placing numbers 1 to 9 in the selected cell using `isValid()`.
-      *   4. Recursively call `solveBoardEfficient()` after placing a valid number.
-      *   5. If the recursive call fails, backtrack by resetting the cell to 0.
-      *   6. If no valid number fits, return false to trigger further backtracking.
+      * `deduce()` runs first, so puzzles that logic alone finishes never enter the search and the
+      * search only sees the residue.
       *
       * @param BOARD A 9x9 Sudoku board to be solved.
       * @return true if the board is successfully solved, false otherwise.
       */
-     // Get the next cell to fill using MRV heuristic
-     auto [row, col, options] = findNextCell(BOARD);
+     NullRecorder recorder;
+     return solveEfficientWith(BOARD, recorder);
+ }
 
-     // If no empty cells are found (row == -1), the board is solved
-     if (row == -1) {
-         return true;
-     }
 
-     // Try placing numbers 1 to 9 in the selected cell
-     for (int k = 1; k <= 9; k++) {
-         if (isValid(BOARD, row, col, k)) {
-             // Place the number
-             BOARD[row][col] = k;
+// ========================= Bitmask Solver ==========================
 
-             // Recursively try to solve the rest of the board
-             if (solveBoardEfficient(BOARD)) {
-                 return true;  // Solution found
-             }
+namespace {
+    // Row/column/box usage masks plus the list of still-empty cells (as r * 9 + c)
+    struct BitmaskState {
+        uint16_t rows[9];
+        uint16_t cols[9];
+        uint16_t boxes[9];
+        int empties[81];
+        int numEmpty;
+    };
 
-             // Backtrack: remove the number if no solution is found
-             BOARD[row][col] = 0;
-         }
+    inline uint16_t candidates(const BitmaskState& state, const int& cell) {
+        return ALL_DIGITS & ~(state.rows[PEER_TABLE.row[cell]] | state.cols[PEER_TABLE.col[cell]] |
+                              state.boxes[PEER_TABLE.box[cell]]);
+    }
+
+    // Builds the masks from the givens; returns false if two givens already conflict
+    bool initBitmaskState(const Board& BOARD, BitmaskState& state) {
+        state.numEmpty = 0;
+        for (int i = 0; i < 9; i++) state.rows[i] = state.cols[i] = state.boxes[i] = 0;
+
+        for (int cell = 0; cell < 81; cell++) {
+            int k = BOARD.cells[cell];
+            if (k == 0) {
+                state.empties[state.numEmpty++] = cell;
+                continue;
+            }
+            if (k < 1 || k > 9) return false;
+            uint16_t bit = 1u << (k - 1);
+            int r = PEER_TABLE.row[cell], c = PEER_TABLE.col[cell], b = PEER_TABLE.box[cell];
+            if ((state.rows[r] | state.cols[c] | state.boxes[b]) & bit) return false;
+            state.rows[r] |= bit;
+            state.cols[c] |= bit;
+            state.boxes[b] |= bit;
+        }
+        return true;
+    }
+
+    // Cells in empties[0 .. depth) are already placed; the rest are still open. Iterative: level
+    // `depth` keeps the untried digits of empties[depth] in options[depth] and the placed one in placed[depth].
+    template <typename Recorder>
+    bool searchBitmask(Board& BOARD, BitmaskState& state, Recorder& recorder) {
+        uint16_t options[81];
+        uint16_t placed[81];
+        int depth = 0;
+        bool descend = true;
+        while (true) {
+            if (descend) {
+                if (depth == state.numEmpty) return true;
+
+                uint64_t start = recorder.clock();
+                // MRV: pick the open cell with the fewest candidates, swap it to position 'depth'
+                int best = depth;
+                int bestCount = 10;
+                for (int i = depth; i < state.numEmpty; i++) {
+                    int cell = state.empties[i];
+                    int count = countBits(candidates(state, cell));
+                    if (count < bestCount) {
+                        bestCount = count;
+                        best = i;
+                        if (count <= 1) break;  // Forced move or dead end, no need to look further
+                    }
+                }
+                recorder.addSelection(start);
+                descend = false;
+                if (bestCount == 0) {
+                    // Dead end: resume the previous level with its next digit
+                    if (depth == 0) return false;
+                    depth--;
+                    continue;
+                }
+                swap(state.empties[depth], state.empties[best]);
+                int cell = state.empties[depth];
+                options[depth] = candidates(state, cell);
+                placed[depth] = 0;
+            }
+
+            int cell = state.empties[depth];
+            int r = PEER_TABLE.row[cell], c = PEER_TABLE.col[cell], b = PEER_TABLE.box[cell];
+            if (placed[depth]) {
+                uint64_t start = recorder.clock();
+                uint16_t bit = placed[depth];
+                state.rows[r] &= ~bit;
+                state.cols[c] &= ~bit;
+                state.boxes[b] &= ~bit;
+                recorder.addPlacement(start);
+                recorder.backtrack();
+                placed[depth] = 0;
+            }
+            if (options[depth] == 0) {
+                BOARD.cells[cell] = 0;
+                if (depth == 0) return false;
+                depth--;
+                continue;
+            }
+
+            if (recorder.stop()) return false;  // Budget used up; the caller restores the board
+            uint16_t bit = options[depth] & (~options[depth] + 1);  // Isolate lowest set bit
+            options[depth] &= options[depth] - 1;
+
+            recorder.node(depth + 1);
+            uint64_t start = recorder.clock();
+            state.rows[r] |= bit;
+            state.cols[c] |= bit;
+            state.boxes[b] |= bit;
+            BOARD.cells[cell] = static_cast<uint8_t>(bitToDigit(bit));
+            recorder.addPlacement(start);
+            placed[depth++] = bit;
+            descend = true;
+        }
+    }
+}
+
+namespace {
+    template <typename Recorder>
+    bool solveBitmaskWith(Board& BOARD, Recorder& recorder) {
+        BitmaskState state;
+        if (!initBitmaskState(BOARD, state)) return false;
+        return searchBitmask(BOARD, state, recorder);
+    }
+}
+
+bool solveBoardBitmask(Board& BOARD) {
+    NullRecorder recorder;
+    return solveBitmaskWith(BOARD, recorder);
+}
+
+
+// ========================= Dancing Links Solutions ==========================
+
+namespace {
+    // The arena is linked once per thread and reused by every later solve
+    DlxSolver& threadDlxSolver() {
+        thread_local DlxSolver solver;
+        return solver;
+    }
+}
+
+ bool solveBoardDlx(Board& BOARD) {
+     return threadDlxSolver().solve(BOARD);
+ }
+
+
+ const char* solveStatusName(const SolveStatus& status) {
+     switch (status) {
+         case SolveStatus::SOLVED: return "solved";
+         case SolveStatus::UNSOLVABLE: return "unsolvable";
+         case SolveStatus::BUDGET_EXCEEDED: return "budget-exceeded";
+     }
+     return "unknown";
+ }
+
+ const char* solverName(const SolverType& solver) {
+     switch (solver) {
+         case SolverType::BASIC: return "basic";
+         case SolverType::EFFICIENT: return "efficient";
+         case SolverType::BITMASK: return "bitmask";
+         case SolverType::DLX: return "dlx";
      }
+     return "unknown";
+ }
 
-     // No valid number fits in this cell, trigger backtracking
+ bool parseSolverType(const string& name, SolverType& solver) {
+     for (const SolverType& candidate : ALL_SOLVER_TYPES) {
+         if (name == solverName(candidate)) {
+             solver = candidate;
+             return true;
+         }
+     }
      return false;
  }
 
 
+ template <typename Recorder>
+ bool solveWithRecorder(Board& board, const SolverType& solver, Recorder& recorder) {
+     switch (solver) {
+         case SolverType::DLX:
+             return threadDlxSolver().solve(board, recorder);
+         case SolverType::BITMASK:
+             return solveBitmaskWith(board, recorder);
+         case SolverType::EFFICIENT:
+             return solveEfficientWith(board, recorder);
+         case SolverType::BASIC:
+         default:
+             return searchRowMajor(board, 0, 0, recorder);
+     }
+ }
+
+ template bool solveWithRecorder<NullRecorder>(Board&, const SolverType&, NullRecorder&);
+ template bool solveWithRecorder<CountingRecorder>(Board&, const SolverType&, CountingRecorder&);
+ template bool solveWithRecorder<TimingRecorder>(Board&, const SolverType&, TimingRecorder&);
+ template bool solveWithRecorder<BudgetRecorder<NullRecorder>>(Board&, const SolverType&, BudgetRecorder<NullRecorder>&);
+ template bool solveWithRecorder<BudgetRecorder<CountingRecorder>>(Board&, const SolverType&, BudgetRecorder<CountingRecorder>&);
+
+ bool solve(Board& board, const SolverType& solver) {
+     NullRecorder recorder;
+     return solveWithRecorder(board, solver, recorder);
+ }
+
+ template <typename Inner>
+ SolveStatus solveWithinBudget(Board& board, const SolverType& solver, const SolveBudget& budget, Inner& inner) {
+     Board original = board;
+     BudgetRecorder<Inner> recorder(inner, budget);
+     if (solveWithRecorder(board, solver, recorder)) return SolveStatus::SOLVED;
+     board = original;  // Failed searches leave partial placements behind
+     return recorder.exceeded ? SolveStatus::BUDGET_EXCEEDED : SolveStatus::UNSOLVABLE;
+ }
+
+ template SolveStatus solveWithinBudget<NullRecorder>(Board&, const SolverType&, const SolveBudget&, NullRecorder&);
+ template SolveStatus solveWithinBudget<CountingRecorder>(Board&, const SolverType&, const SolveBudget&, CountingRecorder&);
+
+ SolveStatus solve(Board& board, const SolverType& solver, const SolveBudget& budget) {
+     NullRecorder recorder;
+     return solveWithinBudget(board, solver, budget, recorder);
+ }
+
+ SolveStatus solve(Board& board, const SolverType& solver, const SolveBudget& budget, SolverStats& stats) {
+     CountingRecorder recorder(stats);
+     return solveWithinBudget(board, solver, budget, recorder);
+ }
+
+ bool solve(Board& board, const SolverType& solver, SolverStats& stats, const bool& timed) {
+     if (timed) {
+         TimingRecorder recorder(stats);
+         return solveWithRecorder(board, solver, recorder);
+     }
+     CountingRecorder recorder(stats);
+     return solveWithRecorder(board, solver, recorder);
+ }
+
+ bool solve(Board& board, const bool& efficient) {
+     return solve(board, efficient ? SolverType::EFFICIENT : SolverType::BASIC);
+ }
+
+
+// ========================= Solution Counting ==========================
+
+namespace {
+    int countWithTracker(CandidateTracker& tracker, const int& limit) {
+        int cell = MrvSelection::select(tracker);
+        if (cell < 0) return 1;  // Board is full: one solution
+
+        int found = 0;
+        uint16_t options = tracker.candidates(cell);
+        while (options && found < limit) {
+            uint16_t bit = options & (~options + 1);
+            options &= options - 1;
+            int digit = bitToDigit(bit);
+
+            tracker.place(cell, digit);
+            found += countWithTracker(tracker, limit - found);
+            tracker.unplace(cell, digit);
+        }
+        return found;
+    }
+}
+
+ int countSolutions(const Board& board, const int& limit) {
+     CandidateTracker tracker;
+     if (limit <= 0 || !tracker.init(board)) return 0;
+     return countWithTracker(tracker, limit);
+ }
+
+ bool hasUniqueSolution(const Board& board) {
+     return countSolutions(board, 2) == 1;
+ }
+
+
+// ===================== int** Adapters =====================
+// The legacy int** API copies into a flat Board, runs the Board implementation and copies back.
+
+ bool solveBoard(int** BOARD, const int& r, const int& c) {
+     Board board = toBoard(BOARD);
+     bool solved = solveBoard(board, r, c);
+     copyToBoard(board, BOARD);
+     return solved;
+ }
+
+ tuple<int, int, int> findNextCell(int** BOARD) {
+     return findNextCell(toBoard(BOARD));
+ }
+
+ bool solveBoardEfficient(int** BOARD) {
+     Board board = toBoard(BOARD);
+     bool solved = solveBoardEfficient(board);
+     copyToBoard(board, BOARD);
+     return solved;
+ }
+
+ bool solveBoardBitmask(int** BOARD) {
+     Board board = toBoard(BOARD);
+     bool solved = solveBoardBitmask(board);
+     copyToBoard(board, BOARD);
+     return solved;
+ }
+
+ bool solveBoardDlx(int** BOARD) {
+     Board board = toBoard(BOARD);
+     bool solved = solveBoardDlx(board);
+     copyToBoard(board, BOARD);
+     return solved;
+ }
+
+ bool solve(int** board, const SolverType& solver) {
+     Board flat = toBoard(board);
+     bool solved = solve(flat, solver);
+     copyToBoard(flat, board);
+     return solved;
+ }
+
+
+ int countSolutions(int** board, const int& limit) {
+     return countSolutions(toBoard(board), limit);
+ }
+
+
  bool solve(int** board, const bool& efficient) {
      // TODO: Implement logic to select the appropriate solver based on the 'efficient' flag
 
@@ -9,26 +9,45 @@
 #include <regex>
 #include <chrono>
 #include <iomanip>  // For formatted output
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include <cstring>
+#include <memory>
 
 #include "../include/generator.h"
 #include "../include/sudoku_io.h"
 #include "../include/utils.h"
 #include "../include/sudoku.h"
+#include "../include/board.h"
+#include "../include/thread_pool.h"
+#include "../include/corpus.h"
+#include "../include/sudoku_parser.h"
+#include "../include/board_sink.h"
+#include "../include/progress.h"
+#include "../include/metrics.h"
+#include "../include/batch_solver.h"
+#include "../include/board_pool.h"
+#include "../include/bitops.h"
+#include "../include/cell_selection.h"
+#include "../include/pipeline.h"
+#include "../include/puzzle_source.h"
+#include "../include/puzzle_bank.h"
 
 using namespace std;
 using namespace std::chrono;
 
-void printBoard(int** BOARD, const int& r, const int& c, int k, const bool& color)
+void printBoard(const Board& BOARD, const int& r, const int& c, int k, const bool& color)
 {
-    if(BOARD[r][c]>0) k = 0;
+    if(BOARD(r, c)>0) k = 0;
 
     for (int i = 0; i < 9; i++)
     {
         for (int j = 0; j < 9; j++)
         {
             string board_piece;
-            if (BOARD[i][j] == 0) board_piece = color ? "\x1B[93m-\x1B[0m" : " "; // Yellow
-            else board_piece = to_string(BOARD[i][j]); // White
+            if (BOARD(i, j) == 0) board_piece = color ? "\x1B[93m-\x1B[0m" : " "; // Yellow
+            else board_piece = to_string(BOARD(i, j)); // White
             if ((i == r && j == c) && k != 0)
             {
                 if (isValid(BOARD, r, c, k))
@@ -49,40 +68,38 @@ void printBoard(int** BOARD, const int& r, const int& c, int k, const bool& colo
     }
 }
 
-void boardToString(int** BOARD, string &content){
-    for(int i = 0; i < 9; i++){
-        for(int j = 0; j < 9; j++){
-            string board_piece;
+void printBoard(int** BOARD, const int& r, const int& c, int k, const bool& color)
+{
+    printBoard(toBoard(BOARD), r, c, k, color);
+}
 
-            if (BOARD[i][j] == 0) content += "-";
-            else content += to_string(BOARD[i][j]);
+void boardToString(const Board& BOARD, string &content){
+    char text[GRID_TEXT_SIZE];
+    content.append(text, formatBoardGrid(BOARD, text));
+}
 
-            if (j == 2 || j == 5)  content += " | ";
-            else content += " ";
-        }
-        if (i == 2 || i == 5)
-        {
-            content += "\n";
-            for (int l = 0; l < 21; l++) content += ".";
-        }
-        content += "\n";
-    }
+void boardToString(int** BOARD, string &content){
+    boardToString(toBoard(BOARD), content);
 }
 
-bool writeSudokuToFile(int** BOARD, const string& filename) {
-    string content;
-    boardToString(BOARD, content);
-    ofstream outFile(filename); // Open file for writing
+bool writeSudokuToFile(const Board& BOARD, const string& filename) {
+    char content[GRID_TEXT_SIZE];
+    int length = formatBoardGrid(BOARD, content);
+    ofstream outFile(filename, ios::binary); // Open file for writing
     if (outFile.is_open()) {
-        outFile << content; // Write content to file
+        outFile.write(content, length); // Write content to file
         outFile.close(); // Close the file
-        cout << "Content has been written to the file: " << filename << endl;
+        if (!isQuietMode()) cout << "Content has been written to the file: " << filename << endl;
         return true;
     }
     cerr << "Unable to open file: " << filename << endl;
     return false;
 }
 
+bool writeSudokuToFile(int** BOARD, const string& filename) {
+    return writeSudokuToFile(toBoard(BOARD), filename);
+}
+
 void replaceCharacter(std::string& str, char oldChar, char newChar) {
     for (char &ch: str) {
         if (ch == oldChar) {
@@ -104,41 +121,82 @@ void extractNumbers(const string& input, vector<int>& numbers) {
 
 void fillBoard(const vector<int>& numbers, int **BOARD){
     for(int i = 0; i < 9; i++) {
-        BOARD[i] = new int[9];
+        // A pooled board already owns its rows; replacing them would corrupt the pool
+        if(!isPooledBoard(BOARD)) BOARD[i] = new int[9];
         for(int j = 0; j < 9; j++){
             BOARD[i][j] = numbers[i * 9 + j];
         }
     }
 }
 
-int** readSudokuFromFile(const string& filename){
-    int** BOARD = new int*[9];
-    vector<int> numbers;
+void fillBoard(const vector<int>& numbers, Board& BOARD){
+    for(int i = 0; i < 81; i++) {
+        BOARD.cells[i] = static_cast<uint8_t>(numbers[i]);
+    }
+}
 
+bool readSudokuFromFile(const string& filename, Board& BOARD){
     ifstream file(filename);
-    string sudoku = string(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
-
-    replaceCharacter(sudoku, '-', '0');
-    extractNumbers(sudoku, numbers);
-    fillBoard(numbers, BOARD);
-    return BOARD;
+    if(!file.is_open()){
+        cerr << "Unable to open file: " << filename << endl;
+        BOARD = Board{};
+        return false;
+    }
+    SudokuParser parser(file);
+    ParseStatus status = parser.next(BOARD);
+    if(status == ParseStatus::OK) return true;
+    if(status == ParseStatus::MALFORMED) cerr << "Malformed Sudoku file: " << filename << " (" << parser.error() << ")" << endl;
+    else cerr << "Malformed Sudoku file: " << filename << " (no puzzle found)" << endl;
+    BOARD = Board{};
+    return false;
 }
 
-bool checkIfSolutionIsValid(int** BOARD){
-    for(int r = 0; r < 9; r++) {
-        for(int c = 0; c < 9; c++) {
-            int k = BOARD[r][c];
-            BOARD[r][c] = 0;
-            if(!isValid(BOARD, r, c, k)){
-                BOARD[r][c] = k;
-                // cout << "!!!!!!!!!!!!!!!! TEST FAILED !!!!!!!!!!!!!!!!" << endl;
-                return false;
-            }
-            BOARD[r][c] = k;
+int readAllSudokusFromFile(const string& filename, vector<Board>& boards){
+    ifstream file(filename);
+    if(!file.is_open()){
+        cerr << "Unable to open file: " << filename << endl;
+        return -1;
+    }
+    SudokuParser parser(file);
+    Board board;
+    int malformed = 0;
+    ParseStatus status;
+    while((status = parser.next(board)) != ParseStatus::END){
+        if(status == ParseStatus::OK){
+            boards.push_back(board);
+        }else{
+            cerr << "Malformed puzzle in " << filename << " (" << parser.error() << ")" << endl;
+            malformed++;
         }
     }
-    // cout << "--------------- TEST PASSED ---------------" << endl;
-    return true;
+    return malformed;
+}
+
+int** readSudokuFromFile(const string& filename){
+    Board board;
+    readSudokuFromFile(filename, board);
+    return toIntBoard(board);
+}
+
+bool checkIfSolutionIsValid(const Board& BOARD){
+    // One pass: every unit has nine cells, so it is complete and duplicate-free iff it has all nine digits
+    uint16_t rows[9] = {0}, cols[9] = {0}, boxes[9] = {0};
+    for(int cell = 0; cell < 81; cell++) {
+        const uint8_t k = BOARD.cells[cell];
+        if(k < 1 || k > 9) return false;
+        const uint16_t bit = static_cast<uint16_t>(1u << (k - 1));
+        rows[PEER_TABLE.row[cell]] |= bit;
+        cols[PEER_TABLE.col[cell]] |= bit;
+        boxes[PEER_TABLE.box[cell]] |= bit;
+    }
+    uint16_t all = ALL_DIGITS;
+    for(int u = 0; u < 9; u++) all &= rows[u] & cols[u] & boxes[u];
+    return all == ALL_DIGITS;
+}
+
+bool checkIfSolutionIsValid(int** BOARD){
+    Board board = toBoard(BOARD);
+    return checkIfSolutionIsValid(board);
 }
 
 vector<string> getAllSudokuInFolder(const string& folderPath){
@@ -149,13 +207,14 @@ vector<string> getAllSudokuInFolder(const string& folderPath){
         }
     }
     cout << sudokus.size() << " Sudoku Puzzle found @ " << folderPath << endl;
+    sort(sudokus.begin(), sudokus.end());
+    if (isQuietMode()) return sudokus;
     cout << setfill('-') << setw(55)<< "" << setfill(' ') <<endl;
     cout << setw(5) << "Index" << setw(50) << "File Name" << endl;
     cout << setfill('-') << setw(55)<< "" << setfill(' ') <<endl;
     for(int i = 0; i < sudokus.size(); i++)
         cout << setw(5) << i << setw(50) << sudokus[i] << endl;
     cout << setfill('-') << setw(55)<< "" << setfill(' ') <<endl;
-    sort(sudokus.begin(), sudokus.end());
     return sudokus;
 }
 
@@ -177,38 +236,325 @@ void createAndSaveNPuzzles(const int& num_puzzles, const int& complexity_empty_b
      * - Set the pointer to nullptr after deallocation to avoid dangling pointers.
      */
     int total_success = 0;
+    const bool quiet = isQuietMode();
+    ProgressReporter progress("generate", num_puzzles);
     for(int i=0; i < num_puzzles; i++){
-        int** BOARD = generateBoard(complexity_empty_boxes);
+        Board BOARD;
+        {
+            StageTimer timer(Stage::GENERATE);
+            generateBoard(BOARD, complexity_empty_boxes);
+        }
         string filename = getFileName(i, destination, prefix);
-        if(writeSudokuToFile(BOARD, filename)){
-            total_success++;
+        bool written;
+        {
+            StageTimer timer(Stage::WRITE);
+            written = writeSudokuToFile(BOARD, filename);
+        }
+        if(written) total_success++;
+        progress.tick(written);
+        if(quiet) continue;
+        if(written){
             cout << "Successfully written(" << filename << ") "<< total_success << "of " << num_puzzles << endl;
         }else{
             cout << "!! Failed to write(" << filename << ") "<< total_success << "of " << num_puzzles << endl;
         }
-        deallocateBoard(BOARD,9);
-        // if(BOARD == nullptr) cout<<"No memory leak"<<endl;
     }
-    cout << total_success << " files written out of " << num_puzzles <<endl;
+    if(quiet) progress.finish();
+    else cout << total_success << " files written out of " << num_puzzles <<endl;
 }
 
+namespace {
+    const int GENERATE_CHUNK = 32;  // Puzzles per pipeline chunk of the generators
+
+    // Makes puzzles 0..num_puzzles-1 with `make(i, board, grade)` and hands each to
+    // `store(i, board, made, grade)` in index order. With workers, chunks run through
+    // runOrderedPipeline(), so an ordered sink never has to park more than the slots in flight.
+    template <typename Make, typename Store>
+    void generateInOrder(const int& num_puzzles, const int& num_workers, Make make, Store store){
+        if(num_workers == 1){
+            for(int i = 0; i < num_puzzles; i++){
+                Board BOARD;
+                Difficulty grade = Difficulty::EASY;
+                const bool made = make(i, BOARD, grade);
+                store(i, BOARD, made, grade);
+            }
+            return;
+        }
+        struct PuzzleChunk {
+            int start = 0;
+            int n = 0;
+            Board boards[GENERATE_CHUNK];
+            bool made[GENERATE_CHUNK];
+            Difficulty grades[GENERATE_CHUNK];
+        };
+        ThreadPool pool(num_workers);
+        int next = 0;
+        auto readChunk = [&](PuzzleChunk& chunk){
+            chunk.start = next;
+            chunk.n = min(GENERATE_CHUNK, num_puzzles - next);
+            next += chunk.n;
+            return chunk.n > 0;
+        };
+        auto makeChunk = [&](PuzzleChunk& chunk){
+            for(int k = 0; k < chunk.n; k++){
+                chunk.grades[k] = Difficulty::EASY;
+                chunk.made[k] = make(chunk.start + k, chunk.boards[k], chunk.grades[k]);
+            }
+        };
+        auto storeChunk = [&](PuzzleChunk& chunk, const bool&){
+            for(int k = 0; k < chunk.n; k++) store(chunk.start + k, chunk.boards[k], chunk.made[k], chunk.grades[k]);
+        };
+        runOrderedPipeline<PuzzleChunk>(pool, 4 * static_cast<size_t>(pool.size()) + 2, readChunk, makeChunk, storeChunk);
+    }
+}
 
-// Function to display a progress bar in the console
-void displayProgressBar(int current, int total, int barWidth = 50) {
-    float progress = static_cast<float>(current) / total;
-    int pos = static_cast<int>(barWidth * progress);
+void createAndSaveNPuzzles(const int& num_puzzles, const int& complexity_empty_boxes, BoardSink& sink, const int& num_workers, const uint64_t& master_seed){
+    const bool quiet = isQuietMode();
+    ProgressReporter progress("generate", num_puzzles);
+    auto makePuzzle = [&](const int& i, Board& BOARD, Difficulty&){
+        // Each worker owns its engine; reseeding per index makes puzzle i independent of scheduling
+        static thread_local RandomEngine engine;
+        engine.seed(derivePuzzleSeed(master_seed, i));
+        StageTimer timer(Stage::GENERATE);
+        generateBoard(BOARD, complexity_empty_boxes, engine);
+        return true;
+    };
+    // Runs on one thread at a time, in index order
+    auto storePuzzle = [&](const int& i, const Board& BOARD, const bool&, const Difficulty&){
+        bool written;
+        {
+            StageTimer timer(Stage::WRITE);
+            written = sink.write(i, BOARD);
+        }
+        progress.tick(written);
+        if(quiet) return;
+        if(written){
+            cout << "Successfully written(" << sink.describe(i) << ") "<< progress.succeeded() << "of " << num_puzzles << endl;
+        }else{
+            cout << "!! Failed to write(" << sink.describe(i) << ") "<< progress.succeeded() << "of " << num_puzzles << endl;
+        }
+    };
+    generateInOrder(num_puzzles, num_workers, makePuzzle, storePuzzle);
+    sink.flush();
+    if(quiet) progress.finish();
+    else cout << progress.succeeded() << " files written out of " << num_puzzles <<endl;
+}
 
-    cout << "\r[";
-    for (int i = 0; i < barWidth; ++i) {
-        if (i < pos) cout << "=";
-        else if (i == pos) cout << ">";
-        else cout << " ";
+void createAndSaveNPuzzles(const int& num_puzzles, const DifficultyTarget& target, BoardSink& sink, const int& num_workers, const uint64_t& master_seed, PuzzleBank* bank){
+    const bool quiet = isQuietMode();
+    ProgressReporter progress("generate", num_puzzles);
+    atomic<int> from_bank(0);
+    auto makePuzzle = [&](const int& i, Board& BOARD, Difficulty& grade){
+        if(bank != nullptr && bank->take(target, BOARD, &grade)){
+            from_bank++;
+            return true;
+        }
+        static thread_local RandomEngine engine;
+        engine.seed(derivePuzzleSeed(master_seed, i));
+        StageTimer timer(Stage::GENERATE);
+        return generateBoardInBand(BOARD, target, engine, &grade);
+    };
+    // Runs on one thread at a time, in index order
+    auto storePuzzle = [&](const int& i, const Board& BOARD, const bool& made, const Difficulty& grade){
+        bool written = false;
+        if(made){
+            StageTimer timer(Stage::WRITE);
+            written = sink.write(i, BOARD);
+        }else{
+            sink.skip(i);
+        }
+        progress.tick(written);
+        if(quiet) return;
+        if(!made){
+            cout << "!! No puzzle in the band for " << sink.describe(i) << endl;
+        }else if(written){
+            cout << "Successfully written(" << sink.describe(i) << ", " << difficultyName(grade) << ") "<< progress.succeeded() << "of " << num_puzzles << endl;
+        }else{
+            cout << "!! Failed to write(" << sink.describe(i) << ") "<< progress.succeeded() << "of " << num_puzzles << endl;
+        }
+    };
+    generateInOrder(num_puzzles, num_workers, makePuzzle, storePuzzle);
+    sink.flush();
+    if(quiet) progress.finish();
+    else cout << progress.succeeded() << " files written out of " << num_puzzles << " (" << from_bank.load() << " from the bank)" <<endl;
+}
+
+void createAndSaveNPuzzles(const int& num_puzzles, const int& complexity_empty_boxes, const string& destination, const string& prefix, const int& num_workers, const uint64_t& master_seed){
+    DirectorySink sink(destination, prefix);
+    createAndSaveNPuzzles(num_puzzles, complexity_empty_boxes, sink, num_workers, master_seed);
+}
+
+void createAndSaveNPuzzlesToCorpus(const int& num_puzzles, const int& complexity_empty_boxes, const string& corpus_path, const int& num_workers, const uint64_t& master_seed){
+    CorpusHeader params;
+    params.empty_boxes = complexity_empty_boxes;
+    params.flags = CORPUS_FLAG_UNIQUE;
+    params.master_seed = master_seed;
+    CorpusSink sink(corpus_path, params);
+    if(!sink.isOpen()) return;
+    createAndSaveNPuzzles(num_puzzles, complexity_empty_boxes, sink, num_workers, master_seed);
+}
+
+namespace {
+    // Search statistics and cache use summed over a whole solve run
+    void printSearchSummary(const SolverStats& stats, const SolutionCache* cache){
+        cout << "search: " << stats.nodes << " nodes, " << stats.backtracks << " backtracks, max depth "
+             << stats.max_depth << ", " << stats.propagation_steps << " propagation steps" << endl;
+        if(cache != nullptr) cout << "cache: " << cache->hits() << " hits, " << cache->misses() << " misses" << endl;
     }
-    cout << "] " << setw(3) << int(progress * 100.0) << "%";
-    cout.flush();
+
+    // The pipelines' solution cache, or nullptr when `capacity` is 0
+    unique_ptr<SolutionCache> makeSolutionCache(const size_t& capacity){
+        return capacity > 0 ? unique_ptr<SolutionCache>(new SolutionCache(capacity)) : nullptr;
+    }
+
+    // Lists the puzzles whose search was stopped by the per-puzzle node budget
+    void printQuarantine(vector<pair<int, string>> puzzles, const uint64_t& node_budget){
+        if(puzzles.empty()) return;
+        sort(puzzles.begin(), puzzles.end());  // Workers finish batches in any order
+        cerr << puzzles.size() << " puzzle(s) quarantined after " << node_budget << " search nodes:" << endl;
+        for(const pair<int, string>& puzzle : puzzles) cerr << "  " << puzzle.second << endl;
+    }
+
+    // Marks which boards of a chunk are solutions fit to write; `index` numbers the puzzles
+    void checkSolutions(const Board* boards, const SolveStatus* status, const int* index, const int& n,
+                        const ValidationMode& mode, bool* valid){
+        if(mode == ValidationMode::FULL) validateBatch(boards, n, valid);
+        for(int k = 0; k < n; k++){
+            if(mode == ValidationMode::SAMPLED){
+                valid[k] = index[k] % VALIDATION_SAMPLE_INTERVAL != 0 || checkIfSolutionIsValid(boards[k]);
+            }else if(mode == ValidationMode::NONE){
+                valid[k] = true;
+            }
+            if(status[k] != SolveStatus::SOLVED){
+                valid[k] = false;
+            }else if(!valid[k]){
+                cerr << "!! Solution of puzzle " << index[k] << " failed validation" << endl;
+            }
+        }
+    }
+}
+
+bool parseValidationMode(const string& name, ValidationMode& mode){
+    if(name == "full") mode = ValidationMode::FULL;
+    else if(name == "sampled") mode = ValidationMode::SAMPLED;
+    else if(name == "none") mode = ValidationMode::NONE;
+    else return false;
+    return true;
 }
 
-void solveAndSaveNPuzzles(const int &num_puzzles, const string& source, const string& destination, const string& prefix){
+SolveJobStatus solveAndSaveCorpus(const string& source, const string& destination, const int& num_workers, const uint64_t& node_budget,
+                                  const ValidationMode& validation, const ShardSpec& shard, const SolverType& engine, const size_t& cache_capacity){
+    CorpusReader reader;
+    if(!reader.open(source)) return SolveJobStatus::FAILED;
+    CorpusHeader params = reader.header();
+    params.flags |= CORPUS_FLAG_SOLVED;
+    uint64_t first, last;
+    shardRange(reader.size(), shard, first, last);
+    // The output is rewritten on every run, so a rerun does not append a second set of solutions
+    const string output = shard.isWhole() ? destination : shardSegmentPath(destination, shard);
+    error_code same_error;
+    if(filesystem::equivalent(source, output, same_error)){
+        cerr << "Refusing to overwrite the puzzle corpus with its solutions: " << output << endl;
+        return SolveJobStatus::FAILED;
+    }
+    std::remove(output.c_str());
+    CorpusSink sink(output, params);
+    if(!sink.isOpen()) return SolveJobStatus::FAILED;
+
+    atomic<int> total_success_solve{0};
+    SolverStats search_stats;
+    vector<pair<int, string>> quarantined;
+    mutex stats_lock;
+    const SolveBudget budget = SolveBudget::nodes(node_budget);
+    unique_ptr<SolutionCache> cache = makeSolutionCache(cache_capacity);  // Repeated and symmetric puzzles are solved once
+    const int available = static_cast<int>(last - first);
+    ProgressReporter progress("solve", available);
+    // Records are solved BATCH_LANES at a time so propagation runs on a whole batch per instruction
+    auto processChunk = [&](const int& start){
+        const int span = min(BATCH_LANES, available - start);
+        int n = 0;  // Records of the span that unpacked; only these are solved
+        Board sudokus[BATCH_LANES];
+        SolveStatus status[BATCH_LANES];
+        int index[BATCH_LANES];
+        {
+            StageTimer timer(Stage::PARSE, span);
+            for(int k = 0; k < span; k++){
+                index[n] = static_cast<int>(first) + start + k;  // Record in the source corpus
+                if(reader.read(index[n], sudokus[n])){
+                    n++;
+                    continue;
+                }
+                cerr << "Corrupt record " << index[n] << " in " << source << endl;
+                sink.skip(start + k);
+                progress.tick(false);
+            }
+        }
+        SolverStats chunk_stats;
+        {
+            StageTimer timer(Stage::SOLVE, n);
+            solveBatch(sudokus, n, status, engine, budget, chunk_stats, cache.get());
+        }
+        bool valid[BATCH_LANES];
+        {
+            StageTimer timer(Stage::VALIDATE, n);
+            checkSolutions(sudokus, status, index, n, validation, valid);
+        }
+        {
+            lock_guard<mutex> guard(stats_lock);
+            search_stats.add(chunk_stats);
+            for(int k = 0; k < n; k++){
+                if(status[k] == SolveStatus::BUDGET_EXCEEDED) quarantined.emplace_back(index[k], "record " + to_string(index[k]));
+            }
+        }
+        for(int k = 0; k < n; k++){
+            const int output_index = index[k] - static_cast<int>(first);
+            bool written = false;
+            if(valid[k]){
+                total_success_solve++;
+                StageTimer timer(Stage::WRITE);
+                written = sink.write(output_index, sudokus[k]);
+            }else{
+                sink.skip(output_index);
+            }
+            progress.tick(written);
+        }
+    };
+
+    if(num_workers == 1){
+        for(int i = 0; i < available; i += BATCH_LANES) processChunk(i);
+    }else{
+        ThreadPool pool(num_workers);
+        for(int i = 0; i < available; i += BATCH_LANES){
+            pool.submit([&processChunk, i](){ processChunk(i); });
+        }
+        pool.wait();
+    }
+    // Unsolved trailing records are not written; pad so the output keeps the source's numbering
+    bool stored = sink.padTo(available);
+    if(!stored) cerr << "Unable to pad corpus: " << output << endl;
+    stored = sink.close() && stored;
+    if(isQuietMode()) progress.finish();
+    cout << total_success_solve << " puzzles solved, " << progress.succeeded() << " written to "
+         << output << " out of " << available << endl;
+    printSearchSummary(search_stats, cache.get());
+    printQuarantine(quarantined, node_budget);
+    const SolveJobStatus result = !stored ? SolveJobStatus::FAILED
+                                : progress.succeeded() == available ? SolveJobStatus::COMPLETE : SolveJobStatus::INCOMPLETE;
+    if(shard.isWhole()) return result;
+    ShardSummary summary;
+    summary.first_record = first;
+    summary.records = last - first;
+    summary.puzzles = static_cast<uint64_t>(available);
+    summary.solved = static_cast<uint64_t>(total_success_solve.load());
+    summary.written = static_cast<uint64_t>(progress.succeeded());
+    summary.quarantined = quarantined.size();
+    summary.search = search_stats;
+    if(!writeShardSummary(shardSummaryPath(output), summary)) return SolveJobStatus::FAILED;
+    return result;
+}
+
+SolveJobStatus solveAndSaveNPuzzles(const int &num_puzzles, const string& source, const string& destination, const string& prefix, const int& num_workers, const uint64_t& node_budget,
+                                    const ValidationMode& validation, const ShardSpec& shard, const SolverType& engine, const size_t& cache_capacity){
     /**
       * TODO:
       * - Identify where in this function dynamically allocated memory (e.g., Sudoku boards) should be deallocated.
@@ -225,31 +571,222 @@ void solveAndSaveNPuzzles(const int &num_puzzles, const string& source, const st
       * - Be mindful of potential memory leaks if the board isn't deallocated properly.
       * - Set the pointer to nullptr after deallocation to avoid dangling pointers.
       */
+    // Three overlapped stages: this thread lists and reads the folder, the pool solves, and a
+    // writer thread writes solutions in read order, so file I/O runs while the workers compute
     int total_success_solve = 0;
     int total_success_write = 0;
-    vector<string> path_to_sudokus = getAllSudokuInFolder(source);
-
-    cout << "Number of loaded puzzles:" << path_to_sudokus.size() << "/" << num_puzzles << endl;
-    for(int i = 0; i < path_to_sudokus.size(); i++){
-        int** sudoku = readSudokuFromFile(path_to_sudokus[i]);
-        if(solve(sudoku)){
-            if(checkIfSolutionIsValid(sudoku)){
-                total_success_solve++;
-                string filename = getFileName(i, destination, prefix);
-                cout << "Puzzle Solved(over available): " << total_success_solve << "/" << path_to_sudokus.size() << " | ";
-                cout << "Puzzle Solved(over total): " << total_success_solve << "/" << num_puzzles << endl;
-                if(writeSudokuToFile(sudoku, filename)){
-                    total_success_write++;
-                }
-                cout << "Puzzle Solved Written(over available): " << total_success_write << "/" << path_to_sudokus.size() << " | ";
-                cout << "Puzzle Solved Written(over total): " << total_success_write << "/" << num_puzzles << endl;
+    SolverStats search_stats;
+    vector<pair<int, string>> quarantined;
+    const SolveBudget budget = SolveBudget::nodes(node_budget);
+    unique_ptr<SolutionCache> cache = makeSolutionCache(cache_capacity);  // Repeated and symmetric puzzles are solved once
+    DirectorySource puzzles(source);
+    if(!puzzles.isOpen()) return SolveJobStatus::FAILED;
+
+    const string output = shard.isWhole() ? destination : shardSegmentPath(destination, shard);
+    if(!shard.isWhole()){
+        error_code error;
+        filesystem::create_directories(output, error);
+    }
+    DirectorySink sink(output, prefix);
+    const bool quiet = isQuietMode();
+    ProgressReporter progress("solve", num_puzzles);
+    ThreadPool pool(num_workers);
+
+    // Puzzles are solved BATCH_LANES at a time so propagation runs on a whole batch per instruction
+    struct FileChunk {
+        int n = 0;
+        string paths[BATCH_LANES];
+        int index[BATCH_LANES];
+        Board sudokus[BATCH_LANES];
+        SolveStatus status[BATCH_LANES];
+        bool valid[BATCH_LANES];
+        SolverStats stats;
+    };
+    int in_shard = 0;
+    auto readChunk = [&](FileChunk& chunk){
+        chunk.n = 0;
+        while(chunk.n < BATCH_LANES && puzzles.next(chunk.paths[chunk.n], chunk.index[chunk.n])){
+            if(!inShard(chunk.paths[chunk.n], shard)) continue;  // Another node's file
+            in_shard++;
+            StageTimer timer(Stage::PARSE);
+            // readSudokuFromFile() reports a file it cannot read; only files that parsed are solved
+            if(readSudokuFromFile(chunk.paths[chunk.n], chunk.sudokus[chunk.n])){
+                chunk.n++;
+            }else{
+                sink.skip(chunk.index[chunk.n]);
+                progress.tick(false);
             }
         }
-        deallocateBoard(sudoku,9);
-        // if(sudoku == nullptr) cout<<"No memory leak"<<endl;
-    }
+        return chunk.n > 0;
+    };
+    auto solveChunk = [&](FileChunk& chunk){
+        chunk.stats = SolverStats();
+        {
+            StageTimer timer(Stage::SOLVE, static_cast<uint64_t>(chunk.n));
+            solveBatch(chunk.sudokus, chunk.n, chunk.status, engine, budget, chunk.stats, cache.get());
+        }
+        StageTimer timer(Stage::VALIDATE, static_cast<uint64_t>(chunk.n));
+        checkSolutions(chunk.sudokus, chunk.status, chunk.index, chunk.n, validation, chunk.valid);
+    };
+    // Only the writer thread touches the totals, so they need no lock
+    auto writeChunk = [&](FileChunk& chunk, const bool&){
+        search_stats.add(chunk.stats);
+        for(int k = 0; k < chunk.n; k++){
+            if(chunk.status[k] == SolveStatus::BUDGET_EXCEEDED) quarantined.emplace_back(chunk.index[k], chunk.paths[k]);
+            if(!chunk.valid[k]){
+                sink.skip(chunk.index[k]);
+                progress.tick(false);
+                continue;
+            }
+            int solved = ++total_success_solve;
+            bool written;
+            {
+                StageTimer timer(Stage::WRITE);
+                written = sink.write(chunk.index[k], chunk.sudokus[k]);
+            }
+            if(written) total_success_write++;
+            progress.tick(written);
+            if(quiet) continue;
+            cout << "Puzzle Solved(over total): " << solved << "/" << num_puzzles << " | ";
+            cout << "Puzzle Solved Written(over total): " << total_success_write << "/" << num_puzzles << endl;
+        }
+    };
+    runOrderedPipeline<FileChunk>(pool, 4 * static_cast<size_t>(pool.size()) + 2, readChunk, solveChunk, writeChunk);
+
+    if(quiet) progress.finish();
+    cout << "Number of loaded puzzles:" << in_shard << "/" << num_puzzles << endl;
+    cout << total_success_solve << " puzzles solved, " << total_success_write << " written out of "
+         << in_shard << " using " << pool.size() << " workers" << endl;
+    printSearchSummary(search_stats, cache.get());
+    printQuarantine(quarantined, node_budget);
+    const SolveJobStatus result = total_success_write == in_shard ? SolveJobStatus::COMPLETE : SolveJobStatus::INCOMPLETE;
+    if(shard.isWhole()) return result;
+    ShardSummary summary;
+    summary.puzzles = static_cast<uint64_t>(in_shard);
+    summary.solved = static_cast<uint64_t>(total_success_solve);
+    summary.written = static_cast<uint64_t>(total_success_write);
+    summary.quarantined = quarantined.size();
+    summary.search = search_stats;
+    if(!writeShardSummary(shardSummaryPath(output), summary)) return SolveJobStatus::FAILED;
+    return result;
 }
 
+SolveJobStatus solveAndSaveStream(const string& source, const string& destination, const TextLayout& layout, const int& num_puzzles,
+                                  const int& num_workers, const uint64_t& node_budget, const ValidationMode& validation,
+                                  const SolverType& engine, const size_t& cache_capacity){
+    ifstream file;
+    if(source != "-"){
+        file.open(source);
+        if(!file.is_open()){
+            cerr << "Unable to open file: " << source << endl;
+            return SolveJobStatus::FAILED;
+        }
+    }
+    SudokuParser parser(source == "-" ? cin : file);
+    StreamSink sink(destination, layout);
+    if(!sink.isOpen()) return SolveJobStatus::FAILED;
+
+    int total_success_solve = 0;
+    int total_success_write = 0;
+    int total_read = 0;
+    SolverStats search_stats;
+    vector<pair<int, string>> quarantined;
+    const SolveBudget budget = SolveBudget::nodes(node_budget);
+    unique_ptr<SolutionCache> cache = makeSolutionCache(cache_capacity);  // Repeated and symmetric puzzles are solved once
+    const bool quiet = isQuietMode();
+    ProgressReporter progress("solve", num_puzzles);
+    ThreadPool pool(num_workers);
+
+    // Same three stages as the folder pipeline. Every puzzle of the stream keeps its slot, so
+    // output board i always belongs to input puzzle i; one that fails is written as an empty board
+    struct TextChunk {
+        int n = 0;
+        int index[BATCH_LANES];
+        Board sudokus[BATCH_LANES];
+        bool loaded[BATCH_LANES];
+        bool valid[BATCH_LANES];
+        SolveStatus status[BATCH_LANES];
+        SolverStats stats;
+    };
+    auto readChunk = [&](TextChunk& chunk){
+        chunk.n = 0;
+        StageTimer timer(Stage::PARSE, 0);
+        ParseStatus parsed;
+        while(chunk.n < BATCH_LANES && (parsed = parser.next(chunk.sudokus[chunk.n])) != ParseStatus::END){
+            chunk.index[chunk.n] = total_read++;
+            chunk.loaded[chunk.n] = parsed == ParseStatus::OK;
+            if(!chunk.loaded[chunk.n]) cerr << "Malformed puzzle in " << source << " (" << parser.error() << ")" << endl;
+            chunk.n++;
+        }
+        timer.setItems(static_cast<uint64_t>(chunk.n));
+        return chunk.n > 0;
+    };
+    auto solveChunk = [&](TextChunk& chunk){
+        // Only the puzzles that parsed are packed into the batch
+        Board batch[BATCH_LANES];
+        int lane[BATCH_LANES];
+        int index[BATCH_LANES];
+        SolveStatus status[BATCH_LANES];
+        bool valid[BATCH_LANES];
+        int m = 0;
+        for(int k = 0; k < chunk.n; k++){
+            chunk.valid[k] = false;
+            chunk.status[k] = SolveStatus::UNSOLVABLE;
+            if(!chunk.loaded[k]) continue;
+            batch[m] = chunk.sudokus[k];
+            index[m] = chunk.index[k];
+            lane[m++] = k;
+        }
+        chunk.stats = SolverStats();
+        {
+            StageTimer timer(Stage::SOLVE, static_cast<uint64_t>(m));
+            solveBatch(batch, m, status, engine, budget, chunk.stats, cache.get());
+        }
+        {
+            StageTimer timer(Stage::VALIDATE, static_cast<uint64_t>(m));
+            checkSolutions(batch, status, index, m, validation, valid);
+        }
+        for(int j = 0; j < m; j++){
+            chunk.sudokus[lane[j]] = batch[j];
+            chunk.status[lane[j]] = status[j];
+            chunk.valid[lane[j]] = valid[j];
+        }
+    };
+    // Only the writer thread touches the totals, so they need no lock
+    auto writeChunk = [&](TextChunk& chunk, const bool&){
+        search_stats.add(chunk.stats);
+        const Board blank{};
+        for(int k = 0; k < chunk.n; k++){
+            if(chunk.status[k] == SolveStatus::BUDGET_EXCEEDED) quarantined.emplace_back(chunk.index[k], "puzzle " + to_string(chunk.index[k]));
+            bool written;
+            {
+                StageTimer timer(Stage::WRITE);
+                written = sink.write(chunk.index[k], chunk.valid[k] ? chunk.sudokus[k] : blank);
+            }
+            if(!chunk.valid[k]){
+                progress.tick(false);
+                continue;
+            }
+            int solved = ++total_success_solve;
+            if(written) total_success_write++;
+            progress.tick(written);
+            if(quiet) continue;
+            cout << "Puzzle Solved(over total): " << solved << "/" << num_puzzles << " | ";
+            cout << "Puzzle Solved Written(over total): " << total_success_write << "/" << num_puzzles << endl;
+        }
+    };
+    runOrderedPipeline<TextChunk>(pool, 4 * static_cast<size_t>(pool.size()) + 2, readChunk, solveChunk, writeChunk);
+
+    const bool stored = sink.flush();
+    if(!stored) cerr << "Unable to write solutions: " << destination << endl;
+    if(quiet) progress.finish();
+    cout << total_success_solve << " puzzles solved, " << total_success_write << " written out of "
+         << total_read << " using " << pool.size() << " workers" << endl;
+    printSearchSummary(search_stats, cache.get());
+    printQuarantine(quarantined, node_budget);
+    if(!stored) return SolveJobStatus::FAILED;
+    return total_success_write == total_read ? SolveJobStatus::COMPLETE : SolveJobStatus::INCOMPLETE;
+}
 
 /**
  * @brief Performs a deep copy of a 9x9 Sudoku board.
@@ -258,15 +795,10 @@ void solveAndSaveNPuzzles(const int &num_puzzles, const string& source, const st
  * @return int** A pointer to the newly allocated deep-copied board.
  */
 int** deepCopyBoard(int** original) {
-    // Allocate memory for the new board
-    int** newBoard = new int*[9];
+    // Take the new board from the pool; the original may still be laid out row by row
+    int** newBoard = getEmptyBoard();
     for (int i = 0; i < 9; i++) {
-        newBoard[i] = new int[9];  // Allocate each row
-
-        // Copy each element from the original board
-        for (int j = 0; j < 9; j++) {
-            newBoard[i][j] = original[i][j];
-        }
+        memcpy(newBoard[i], original[i], 9 * sizeof(int));
     }
     return newBoard;
 }
@@ -290,24 +822,30 @@ void compareSudokuSolvers(const int& experiment_size, const int& empty_boxes) {
      */
     double totalTimeSolveBoard = 0.0;
     double totalTimeEfficientSolveBoard = 0.0;
+    double totalTimeBitmaskSolveBoard = 0.0;
+    double totalTimeDlxSolveBoard = 0.0;
 
     int validSolutionsSolveBoard = 0;
     int validSolutionsEfficientSolveBoard = 0;
+    int validSolutionsBitmaskSolveBoard = 0;
+    int validSolutionsDlxSolveBoard = 0;
 
-    int** board1 = nullptr;
-    int** board2 = nullptr;
+    Board board1;
+    Board board2;
+    Board board3;
+    Board board4;
     bool solved = false;
 
     cout << "Running Sudoku Solver Comparisons...\n";
+    // One line per second at most, instead of redrawing a bar after every board
+    ProgressReporter progress("compare", experiment_size);
 
     for (int i = 1; i <= experiment_size; ++i) {
         // Generate a single board and deep copy
-        board1 = generateBoard(empty_boxes);  // Fresh board for efficient solver
-        if (!board1) {
-            cerr << "Failed to generate board.\n";
-            continue;
-        }
-        board2 = deepCopyBoard(board1);       // Deep copy for regular solver
+        generateBoard(board1, empty_boxes, GenerationMode::RANDOM);  // Exact blank count for the comparison
+        board2 = board1;                     // Flat copy for regular solver
+        board3 = board1;                     // Flat copy for bitmask solver
+        board4 = board1;                     // Flat copy for DLX solver
 
         // -------------------- Testing solveBoardEfficient --------------------
         auto startEfficient = high_resolution_clock::now();
@@ -340,14 +878,41 @@ void compareSudokuSolvers(const int& experiment_size, const int& empty_boxes) {
             cerr << "solveBoard produced an invalid solution.\n";
         }
 
-        deallocateBoard(board1,9);
-        deallocateBoard(board2,9);
-        // if(board1 == nullptr && board2 == nullptr) cout<<"No memory leak"<<endl;
-        // -------------------- Progress Bar Update --------------------
-        displayProgressBar(i, experiment_size);
+        // -------------------- Testing solveBoardBitmask --------------------
+        auto startBitmask = high_resolution_clock::now();
+        solved = solve(board3, SolverType::BITMASK);  // Solve using bitmask solver
+        auto endBitmask = high_resolution_clock::now();
+
+        double elapsedBitmask = duration<double>(endBitmask - startBitmask).count();
+        totalTimeBitmaskSolveBoard += elapsedBitmask;
+
+        // Validate solution
+        if (solved && checkIfSolutionIsValid(board3)) {
+            validSolutionsBitmaskSolveBoard++;
+        } else {
+            cerr << "solveBoardBitmask produced an invalid solution.\n";
+        }
+
+        // -------------------- Testing solveBoardDlx --------------------
+        auto startDlx = high_resolution_clock::now();
+        solved = solve(board4, SolverType::DLX);  // Solve using Dancing Links
+        auto endDlx = high_resolution_clock::now();
+
+        double elapsedDlx = duration<double>(endDlx - startDlx).count();
+        totalTimeDlxSolveBoard += elapsedDlx;
+
+        // Validate solution
+        if (solved && checkIfSolutionIsValid(board4)) {
+            validSolutionsDlxSolveBoard++;
+        } else {
+            cerr << "solveBoardDlx produced an invalid solution.\n";
+        }
+
+        // -------------------- Progress Update --------------------
+        progress.tick();
     }
 
-    cout << endl;  // Move to the next line after progress bar is done.
+    progress.finish();
 
     // -------------------- Summary --------------------
     cout << "====================== Performance Summary (Empty Boxes: " << empty_boxes << ") ======================" << endl;
@@ -364,5 +929,17 @@ void compareSudokuSolvers(const int& experiment_size, const int& empty_boxes) {
          << 1000 * (totalTimeEfficientSolveBoard / experiment_size) << " milliseconds" << endl;
     cout << "efficientSolveBoard valid solutions: " << validSolutionsEfficientSolveBoard << "/" << experiment_size << endl;
 
+    cout << "-------------------------------------------------------------" << endl;
+
+    cout << "bitmaskSolveBoard average time: " << fixed << setprecision(4)
+         << 1000 * (totalTimeBitmaskSolveBoard / experiment_size) << " milliseconds" << endl;
+    cout << "bitmaskSolveBoard valid solutions: " << validSolutionsBitmaskSolveBoard << "/" << experiment_size << endl;
+
+    cout << "-------------------------------------------------------------" << endl;
+
+    cout << "dlxSolveBoard average time: " << fixed << setprecision(4)
+         << 1000 * (totalTimeDlxSolveBoard / experiment_size) << " milliseconds" << endl;
+    cout << "dlxSolveBoard valid solutions: " << validSolutionsDlxSolveBoard << "/" << experiment_size << endl;
+
     cout << "===========================================================================" << endl;
 }
\ No newline at end of file
@@ -0,0 +1,94 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/sudoku_parser.h"
+
+using namespace std;
+
+namespace {
+    inline bool isBlankChar(const char& ch) {
+        return ch == '0' || ch == '.' || ch == '-';
+    }
+
+    inline bool isSpace(const char& ch) {
+        return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+    }
+
+    // [begin, end) of the line without surrounding whitespace
+    void trim(const string& text, size_t& begin, size_t& end) {
+        begin = 0;
+        end = text.size();
+        while (begin < end && isSpace(text[begin])) begin++;
+        while (end > begin && isSpace(text[end - 1])) end--;
+    }
+
+    bool parseLineRange(const string& text, const size_t& begin, const size_t& end, Board& board) {
+        if (end - begin != 81) return false;
+        for (size_t i = 0; i < 81; i++) {
+            char ch = text[begin + i];
+            if (ch >= '1' && ch <= '9') board.cells[i] = static_cast<uint8_t>(ch - '0');
+            else if (isBlankChar(ch)) board.cells[i] = 0;
+            else return false;
+        }
+        return true;
+    }
+}
+
+bool parseSudokuLine(const string& text, Board& board) {
+    size_t begin, end;
+    trim(text, begin, end);
+    return parseLineRange(text, begin, end, board);
+}
+
+void boardToLine(const Board& board, string& content) {
+    content.resize(81);
+    for (int i = 0; i < 81; i++) {
+        content[i] = board.cells[i] == 0 ? '.' : static_cast<char>('0' + board.cells[i]);
+    }
+}
+
+ParseStatus SudokuParser::fail(const string& reason) {
+    message = "line " + to_string(line_number) + ": " + reason;
+    return ParseStatus::MALFORMED;
+}
+
+ParseStatus SudokuParser::next(Board& board) {
+    int filled = 0;  // Cells collected so far for a grid-layout puzzle
+    while (getline(in, line)) {
+        line_number++;
+        size_t begin, end;
+        trim(line, begin, end);
+
+        if (begin == end) {
+            // Blank lines separate puzzles; one in the middle of a grid means rows are missing
+            if (filled > 0) return fail("incomplete grid (" + to_string(filled) + " of 81 cells)");
+            continue;
+        }
+
+        // Line layout: a whole puzzle on one line
+        if (filled == 0 && end - begin == 81 && line.find_first_of(" \t|", begin) >= end) {
+            if (parseLineRange(line, begin, end, board)) return ParseStatus::OK;
+            return fail("invalid character in 81-character puzzle line");
+        }
+
+        if (line[begin] == '+') continue;  // "+-------+" style border in a grid
+
+        // Grid layout: digits and '-' are cells, spaces, '|' and '.' are separators
+        for (size_t i = begin; i < end; i++) {
+            char ch = line[i];
+            if (ch == ' ' || ch == '\t' || ch == '|' || ch == '.') continue;
+            if (ch >= '0' && ch <= '9') {
+                if (filled == 81) return fail("more than 81 cells in grid");
+                board.cells[filled++] = static_cast<uint8_t>(ch - '0');
+            } else if (ch == '-') {
+                if (filled == 81) return fail("more than 81 cells in grid");
+                board.cells[filled++] = 0;
+            } else {
+                return fail(string("unexpected character '") + ch + "'");
+            }
+        }
+        if (filled == 81) return ParseStatus::OK;
+    }
+    if (filled > 0) return fail("incomplete grid (" + to_string(filled) + " of 81 cells)");
+    return ParseStatus::END;
+}
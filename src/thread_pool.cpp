@@ -0,0 +1,105 @@
+//
+// Created by Keshav Bhandari on 2/7/25.
+//
+#include "../include/thread_pool.h"
+
+using namespace std;
+
+namespace {
+    thread_local int CURRENT_WORKER = -1;
+    thread_local const void* CURRENT_POOL = nullptr;
+}
+
+int resolveWorkerCount(const int& requested) {
+    if (requested > 0) return requested;
+    unsigned cores = thread::hardware_concurrency();
+    return cores == 0 ? 1 : static_cast<int>(cores);
+}
+
+ThreadPool::ThreadPool(const int& num_workers) {
+    int count = resolveWorkerCount(num_workers);
+    for (int i = 0; i < count; i++) queues.push_back(make_unique<WorkerQueue>());
+    for (int i = 0; i < count; i++) workers.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        lock_guard<mutex> guard(wake_lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (thread& worker : workers) worker.join();
+}
+
+int ThreadPool::currentWorker() {
+    return CURRENT_WORKER;
+}
+
+void ThreadPool::submit(function<void()> task) {
+    // Workers keep their own follow-up tasks local; outside callers spread round-robin
+    int target = (CURRENT_POOL == this) ? CURRENT_WORKER
+                                         : static_cast<int>(next_queue++ % queues.size());
+    pending++;
+    {
+        lock_guard<mutex> guard(queues[target]->lock);
+        queues[target]->tasks.push_back(move(task));
+    }
+    queued++;
+    {
+        lock_guard<mutex> guard(wake_lock);
+    }
+    wake.notify_one();
+}
+
+void ThreadPool::wait() {
+    unique_lock<mutex> guard(wake_lock);
+    done.wait(guard, [this]() { return pending.load() == 0; });
+}
+
+bool ThreadPool::popTask(const int& worker, function<void()>& task) {
+    // Own deque first (newest task, still warm in cache) ...
+    {
+        WorkerQueue& own = *queues[worker];
+        lock_guard<mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            task = move(own.tasks.back());
+            own.tasks.pop_back();
+            queued--;
+            return true;
+        }
+    }
+    // ... then steal the oldest task of another worker
+    int count = static_cast<int>(queues.size());
+    for (int offset = 1; offset < count; offset++) {
+        WorkerQueue& victim = *queues[(worker + offset) % count];
+        lock_guard<mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = move(victim.tasks.front());
+            victim.tasks.pop_front();
+            queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::workerLoop(const int& worker) {
+    CURRENT_WORKER = worker;
+    CURRENT_POOL = this;
+    function<void()> task;
+    while (true) {
+        if (popTask(worker, task)) {
+            task();
+            task = nullptr;
+            if (--pending == 0) {
+                lock_guard<mutex> guard(wake_lock);
+                done.notify_all();
+            }
+            continue;
+        }
+        unique_lock<mutex> guard(wake_lock);
+        wake.wait(guard, [this]() { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) return;
+    }
+}
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <string>
 #include <filesystem>
+#include "../include/board_pool.h"
 using namespace std;
 
 void deallocateBoard(int** &BOARD, const int& rows) {
@@ -16,6 +17,8 @@ void deallocateBoard(int** &BOARD, const int& rows) {
      * - Set BOARD to nullptr to avoid dangling pointers.
      */
     if(BOARD == nullptr) return;
+    // Boards from getEmptyBoard() go back to this thread's pool for the next one
+    if(rows == 9 && releaseBoard(BOARD)) return;
     for(int i = 0;i<rows;i++) {
         delete[] BOARD[i];
         //No need to assign nullptr for BOARD[i],
@@ -45,7 +48,8 @@ void initDataFolder(){
 
 string getFileName(const int& index, const string& destination, const string& prefix){
     string index_str = to_string(index);
-    string index_fill = string(4 - index_str.length(), '0');
+    // Indexes of five or more digits are written as they are
+    string index_fill = index_str.length() < 4 ? string(4 - index_str.length(), '0') : "";
     string filename = destination + index_fill + index_str + prefix + ".txt";
     return filename;
 }